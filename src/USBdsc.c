@@ -32,23 +32,28 @@ const unsigned int USB_PRODUCT_ID = 0x4221;  // 'B!'
 const char USB_SELF_POWER = 0x80;            // 0x80 = Bus powered, 0xC0 = Self powered
 const char USB_MAX_POWER = 50;               // Bus power required in units of 2 mA
 const char USB_TRANSFER_TYPE = 0x03;         // 0x03 = Interrupt transfers
-const char EP_IN_INTERVAL = 5;               // Measured in frame counts i.e. 1 ms units for Low Speed (1.5 Mbps) or Full Speed (12 Mbps), and 125 us units for High Speed (480 Mbps)
+#ifndef EP_INTERVAL
+#define EP_INTERVAL 1                        // Endpoint polling interval in ms (1 to 255). Increase it if a host
+                                             // cannot keep up, but each keystroke then takes at least this long
+#endif
+const char EP_IN_INTERVAL = EP_INTERVAL;     // Measured in frame counts i.e. 1 ms units for Low Speed (1.5 Mbps) or Full Speed (12 Mbps), and 125 us units for High Speed (480 Mbps)
                                              // This device supportseither Low Speed (FSEN=0, 6 MHz USB clock) or Full Speed (FSEN=1, 48 MHz USB clock) mode.
                                              // PIC 18F25K50 does not support USB High Speed mode
                                              // n x 1 millisecond units (for USB Low/Full Speed devices)
                                              // 2**(n-1) x 125 microsecond units (for USB2 High Speed devices)
                                              // The Host interrupts PIC for keyboard input this often.
 
-const char EP_OUT_INTERVAL = 5;              // n x 1 millisecond units (for USB Low/Full Speed devices)
+const char EP_OUT_INTERVAL = EP_INTERVAL;    // n x 1 millisecond units (for USB Low/Full Speed devices)
                                              // 2**(n-1) x 125 microsecond units (for USB2 High Speed devices)
                                              // The Host interrupts PIC for LED status output at most this often (if LED status change is pending).
 
 const char USB_INTERRUPT = 1;
 const char USB_HID_EP = 1;
-const char USB_HID_RPT_SIZE = 50   // Keyboard       --> host
+const char USB_HID_RPT_SIZE = 52   // Keyboard       --> host
                             + 21   // Keyboard       <-- host
                             + 25   // SystemControl  --> host
-                            + 25;  // ConsumerDevice --> host
+                            + 25   // ConsumerDevice --> host
+                            + 27;  // Program        <-> host
 /* Device Descriptor */
 const struct
 {
@@ -110,7 +115,7 @@ const char configDescriptor1[] =
                             // Class Subclass Protocol Meaning
                             //   3       0       0     Class=HID with no specific Subclass or Protocol: 
                             //                         Can have ANY size reports (not just 8-byte reports)
-                            //                         IRK! uses 3-byte reports because it only ever sends one key press at a time
+                            //                         PUB! uses 9-byte keyboard reports so that it can send up to 6 key presses at a time
                             //   3       1       1     Class=HID, Subclass=BOOT device, Protocol=keyboard: 
                             //                         REQUIRES 8-byte reports in order for it to be recognised by BIOS when booting.
                             //                         That is because the entire USB protocol cannot be implemented in BIOS, so
@@ -134,7 +139,7 @@ const char configDescriptor1[] =
     0x05,                   // bDescriptorType - The constant Endpoint (05h)
     USB_HID_EP | 0x80,      // bEndpointAddress - Endpoint number (0x01) and direction (0x80 = IN to host)
     USB_TRANSFER_TYPE,      // bmAttributes - Transfer type and supplementary information
-    0x08,0x00,              // wMaxPacketSize - Maximum packet size supported
+    0x20,0x00,              // wMaxPacketSize - Maximum packet size supported (the program report is 20 bytes)
                             // This determines the size of the transmission time slot allocated to this device
     EP_IN_INTERVAL,         // bInterval - Service interval or NAK rate
 
@@ -143,7 +148,7 @@ const char configDescriptor1[] =
     0x05,                   // bDescriptorType - The constant Endpoint (05h)
     USB_HID_EP,             // bEndpointAddress - Endpoint number (0x01) and direction (0x00 = OUT from host)
     USB_TRANSFER_TYPE,      // bmAttributes - Transfer type and supplementary information
-    0x08,0x00,              // wMaxPacketSize - Maximum packet size supported
+    0x20,0x00,              // wMaxPacketSize - Maximum packet size supported (the program report is 20 bytes)
                             // This determines the size of the transmission time slot allocated to this device
     EP_OUT_INTERVAL         // bInterval - Service interval or NAK rate
 };
@@ -165,7 +170,7 @@ const struct
 //    or not.
 
 /*
-Keyboard Input Report (PIC --> Host) 4 bytes as follows:
+Keyboard Input Report (PIC --> Host) 9 bytes as follows:
     .---------------------------------------.
     |          REPORT_ID_KEYBOARD           | IN: Report Id
     |---------------------------------------|
@@ -173,7 +178,11 @@ Keyboard Input Report (PIC --> Host) 4 bytes as follows:
     |---------------------------------------|
     |                (pad)                  | IN: pad (strangely, this pad byte is necessary)
     |---------------------------------------|
-    |                 Key                   | IN: Key that is currently pressed
+    |                 Key 1                 | IN: Keys that are currently pressed (0 = unused slot)
+    |---------------------------------------|
+    |                  ...                  |
+    |---------------------------------------|
+    |                 Key 6                 |
     '---------------------------------------'
 */
   0x05, 0x01,                  // (GLOBAL) USAGE_PAGE         0x0001 Generic Desktop Page
@@ -201,7 +210,8 @@ Keyboard Input Report (PIC --> Host) 4 bytes as follows:
   0x26, 0xFF, 0x00,            //   (GLOBAL) LOGICAL_MAXIMUM    0x00FF (255)
   0x19, 0x00,                  //   (LOCAL)  USAGE_MINIMUM      0x00070000 Keyboard No event indicated (Sel=Selector) <-- Redundant: USAGE_MINIMUM is already 0x0000
   0x2A, 0xFF, 0x00,            //   (LOCAL)  USAGE_MAXIMUM      0x000700FF
-  0x81, 0x00,                  //   (MAIN)   INPUT              0x00000000 (1 field x 8 bits) 0=Data 0=Array 0=Absolute 0=Ignored 0=Ignored 0=PrefState 0=NoNull
+  0x95, MAX_KEYS,              //   (GLOBAL) REPORT_COUNT       0x06 (6) Number of fields
+  0x81, 0x00,                  //   (MAIN)   INPUT              0x00000000 (6 fields x 8 bits) 0=Data 0=Array 0=Absolute 0=Ignored 0=Ignored 0=PrefState 0=NoNull
 /*
 Output Report (PIC <-- Host) 2 bytes as follows:
 
@@ -266,6 +276,38 @@ Consumer Device Input Report (PIC --> Host) 3 bytes as follows:
   0x95, 0x01,                  //   (GLOBAL) REPORT_COUNT       0x01 (1) Number of fields <-- Redundant: REPORT_COUNT is already 1
   0x81, 0x00,                  //   (MAIN)   INPUT              0x00000000 (1 field x 16 bits) 0=Data 0=Array 0=Absolute 0=Ignored 0=Ignored 0=PrefState 0=NoNull
   0xC0,                        // (MAIN)   END_COLLECTION     Application
+
+/*
+Program Output Report (PIC <-- Host) and Input Report (PIC --> Host) 20 bytes as follows:
+    .---------------------------------------.
+    |           REPORT_ID_PROGRAM           | IN/OUT: Report Id
+    |---------------------------------------|
+    |                Command                | IN/OUT: Read, Write, Save or Load (echoed in the reply)
+    |---------------------------------------|
+    |                Offset                 | IN/OUT: Offset of the block in the program image
+    |---------------------------------------|
+    |                Status                 | IN: 0 = OK (ignored on OUT)
+    |---------------------------------------|
+    |              Data byte 1              | IN/OUT: Block of the program image
+    |---------------------------------------|
+    |                  ...                  |
+    |---------------------------------------|
+    |              Data byte 16             |
+    '---------------------------------------'
+*/
+  0x06, 0x00, 0xFF,            // (GLOBAL) USAGE_PAGE         0xFF00 Vendor-defined
+  0x09, 0x01,                  // (LOCAL)  USAGE              0xFF000001 (CA=Application Collection)
+  0xA1, 0x01,                  // (MAIN)   COLLECTION         0x01 Application (Usage=0xFF000001: Page=Vendor-defined, Usage=1, Type=CA)
+  0x85, REPORT_ID_PROGRAM,     //   (GLOBAL) REPORT_ID          0x50 (80) 'P'
+  0x15, 0x00,                  //   (GLOBAL) LOGICAL_MINIMUM    0x00 (0)
+  0x26, 0xFF, 0x00,            //   (GLOBAL) LOGICAL_MAXIMUM    0x00FF (255)
+  0x75, 0x08,                  //   (GLOBAL) REPORT_SIZE        0x08 (8) Number of bits per field
+  0x95, 3+PROGRAM_BLOCK_SIZE,  //   (GLOBAL) REPORT_COUNT       0x13 (19) Number of fields
+  0x09, 0x02,                  //   (LOCAL)  USAGE              0xFF000002
+  0x81, 0x02,                  //   (MAIN)   INPUT              0x00000002 (19 fields x 8 bits) 0=Data 1=Variable 0=Absolute 0=NoWrap 0=Linear 0=PrefState 0=NoNull 0=NonVolatile 0=Bitmap
+  0x09, 0x03,                  //   (LOCAL)  USAGE              0xFF000003
+  0x91, 0x02,                  //   (MAIN)   OUTPUT             0x00000002 (19 fields x 8 bits) 0=Data 1=Variable 0=Absolute 0=NoWrap 0=Linear 0=PrefState 0=NoNull 0=NonVolatile 0=Bitmap
+  0xC0,                        // (MAIN)   END_COLLECTION     Application
     }
   };
 
@@ -1,6 +1,10 @@
 #define REPORT_ID_KEYBOARD          'K'
 #define REPORT_ID_SYSTEM_CONTROL    'S'
 #define REPORT_ID_CONSUMER_DEVICE   'C'
+#define REPORT_ID_PROGRAM           'P'
+
+#define MAX_KEYS                    6   // Number of key slots in the keyboard input report
+#define PROGRAM_BLOCK_SIZE          16  // Number of program image bytes in each program report
 
 
 #define USB_KEY_A   0x04
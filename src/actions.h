@@ -0,0 +1,321 @@
+/*
+  PUB! Programmable USB Button
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// The action encoding and the text used to list actions. This is plain C so
+// that the host tools (see tools/pubasm.c) list and assemble actions using
+// the very same tables as the device. The names of the HID usages, and the
+// system control and consumer device usages that have them, are in
+// usagenames.h, which the device uses packed (see usagetext.h).
+
+#define MODIFIER_LEFTSHIFT   0b0001
+#define MODIFIER_LEFTCTL     0b0010
+#define MODIFIER_LEFTALT     0b0100
+#define MODIFIER_LEFTGUI     0b1000
+
+const char MODIFIER_ORDER[] =          // Order the modifiers are listed in
+{
+  MODIFIER_LEFTGUI, MODIFIER_LEFTCTL, MODIFIER_LEFTALT, MODIFIER_LEFTSHIFT,
+};
+
+const char * const MODIFIER_DESC[] =
+{
+  "GUI+",           "CTL+",           "ALT+",           "SHIFT+",
+};
+
+#define FORMAT_HEX  0
+#define FORMAT_DEC  1
+#define FORMAT_CHAR 2
+
+const char * const FORMAT_DESC[] =
+{
+  "Hex", "Decimal", "Char",
+};
+
+// How the operand of an instruction is listed after its description
+#define OPERAND_HEX      0   // 2 hex digits
+#define OPERAND_FORMAT   1   // FORMAT_DESC
+#define OPERAND_MS       2   // Decimal then " ms"
+#define OPERAND_SEC      3   // Decimal then " sec"
+#define OPERAND_SIGNED   4   // " by " then signed decimal
+#define OPERAND_ADDRESS  5   // " to " then 2 hex digits
+#define OPERAND_NONE     6   // Nothing
+#define OPERAND_OFFSET   7   // 2 hex digits then ")"
+
+#define MAX_ACTIONS                125  // Actions in a program (a saved copy of 125
+                                          // actions is 256 bytes: see storage.h)
+
+#define PAGE_KEYBOARD              0x0
+
+#define PAGE_SYSTEM_CONTROL        0x1
+
+#define PAGE_CONSUMER_DEVICE       0x2
+
+#define PAGE_TEXT                  0x3
+  // A text run is a 30nn header, where nn is the number of characters,
+  // followed by the characters packed two to an action (the first in the
+  // high byte). They are typed the same way as SAY types them.
+  #define TEXT_SLOTS(n)              (((n)+1)/2)  // Actions needed for n characters
+  #define MAX_TEXT_LENGTH            (2 * (MAX_ACTIONS - 1))
+
+#define PAGE_REGISTER              0xA
+  // Instructions that use the index register X, or a register pair RRnn
+  // (Rnn holds the low byte and Rnn+1 the high byte of a 16-bit value)
+  #define REGISTER_SET_INDEX         0x0  // X = xx
+  #define REGISTER_GET_INDEXED       0x1  // W <- [X+xx]
+  #define REGISTER_PUT_INDEXED       0x2  // W -> [X+xx]
+  #define REGISTER_ADD_INDEX         0x3  // X = X + xx
+  #define REGISTER_GET_INDEX         0x4  // X <- [xx]
+  #define REGISTER_PUT_INDEX         0x5  // X -> [xx]
+  #define REGISTER_LOOP_W            0x6  // W = W - 1, then jump to aa if not zero
+  #define REGISTER_LOOP_X            0x7  // X = X - 1, then jump to aa if not zero
+  #define REGISTER_PUT_PAIR          0x8  // W -> [xx+1,xx] (high byte 0)
+  #define REGISTER_ADD_PAIR          0x9  // [xx+1,xx] = [xx+1,xx] + W
+  #define REGISTER_SUB_PAIR          0xA  // [xx+1,xx] = [xx+1,xx] - W
+  #define REGISTER_SAY_PAIR          0xB  // SAY f([xx+1,xx],format)
+  //      REGISTER_                  0xC
+  //      REGISTER_                  0xD
+  //      REGISTER_                  0xE
+  //      REGISTER_                  0xF
+
+#define PAGE_CONTROL               0xC
+  #define CONTROL_CHAIN              0x0  // Load program nn and play it from the start
+  #define CONTROL_CALL               0x1  // Play the actions from address nn until a Return
+  #define CONTROL_RETURN             0x2  // Carry on after the last Call (or stop, if none)
+  //      CONTROL_                   0x3
+  //      CONTROL_                   0x4
+  //      CONTROL_                   0x5
+  //      CONTROL_                   0x6
+  //      CONTROL_                   0x7
+  //      CONTROL_                   0x8
+  //      CONTROL_                   0x9
+  //      CONTROL_                   0xA
+  //      CONTROL_                   0xB
+  //      CONTROL_                   0xC
+  //      CONTROL_                   0xD
+  //      CONTROL_                   0xE
+  //      CONTROL_                   0xF
+
+#define PAGE_DO                    0xD
+  #define DO_DELETE                  0x0
+  #define DO_REDISPLAY               0x1
+  #define DO_CALIBRATE               0x2
+  #define DO_STATISTICS              0x3
+  //      DO_                        0x4
+  //      DO_                        0x5
+  //      DO_                        0x6
+  //      DO_                        0x7
+  //      DO_                        0x8
+  //      DO_                        0x9
+  //      DO_                        0xA
+  //      DO_                        0xB
+  //      DO_                        0xC
+  //      DO_                        0xD
+  #define DO_LOAD                    0xE  // Load program nn
+  #define DO_SAVE                    0xF  // Save as program nn
+
+#define PAGE_EXECUTE               0xE
+  #define EXECUTE_SET                0x0
+  #define EXECUTE_GET                0x1
+  #define EXECUTE_PUT                0x2
+  #define EXECUTE_COMPARE_IMMEDIATE  0x3
+  #define EXECUTE_COMPARE            0x4
+  #define EXECUTE_SAY                0x5
+  #define EXECUTE_FORMAT             0x6
+  #define EXECUTE_ADD_IMMEDIATE      0x7
+  #define EXECUTE_SUB_IMMEDIATE      0x8
+  #define EXECUTE_CLEAR              0x9
+  #define EXECUTE_ADD                0xA
+  #define EXECUTE_SUB                0xB
+  #define EXECUTE_MUL                0xC
+  #define EXECUTE_DIV                0xD
+  #define EXECUTE_WAIT_MS            0xE
+  #define EXECUTE_WAIT_SEC           0xF
+
+#define PAGE_JUMP                  0xF
+  #define JUMP_RELATIVE              0x0
+  #define JUMP_IF_CARRY              0x1
+  #define JUMP_IF_HIGH               0x2
+  #define JUMP_IF_HIGH_OR_CARRY      0x3
+  #define JUMP_IF_LOW                0x4
+  #define JUMP_IF_LOW_OR_CARRY       0x5
+  #define JUMP_IF_NOT_ZERO_OR_CARRY  0x6
+  #define JUMP_IF_NOT_ZERO           0x7
+  #define JUMP_IF_ZERO               0x8
+  #define JUMP_IF_ZERO_OR_CARRY      0x9
+  #define JUMP_IF_NOT_LOW_OR_CARRY   0xA
+  #define JUMP_IF_NOT_LOW            0xB
+  #define JUMP_IF_ZERO_OR_LOW        0xC
+  #define JUMP_IF_NOT_HIGH           0xD
+  #define JUMP_IF_NOT_CARRY          0xE
+  #define JUMP                       0xF
+
+
+const char ASCII_to_USB[] =
+{ // Top bit on means capitalise with Left Shift
+  //         00    01    02    03    04    05    06    07    08    09    0A    0B    0C    0D    0E    0F
+  //        NUL   SOH   STX   ETX   EOT   ENQ   ACK   BEL    BS    HT    LF    VT    FF    CR    SO    SI
+  /* 00 */ 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2A, 0x2B, 0x28, 0x2C, 0x2C, 0x4A, 0x2C, 0x2C,
+  //        DLE   DC1   DC2   DC3   DC4   NAK    SYN  ETB   CAN    EM   SUB   ESC    FS    GS    RS    US
+  /* 10 */ 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C,
+  //                !     "     #     $     %     &     '     (     )     *     +     ,     -     .     /
+  /* 20 */ 0x2C, 0x9E, 0xB4, 0xA0, 0xA1, 0xA2, 0xA4, 0x34, 0xA6, 0xA7, 0xA5, 0xAE, 0x36, 0x2D, 0x37, 0x38,
+  //          0     1     2     3     4     5     6     7     8     9     :     ;     <     =     >     ?
+  /* 30 */ 0x27, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0xB3, 0x33, 0xB6, 0x2E, 0xB7, 0xB8,
+  //          @     A     B     C     D     E     F     G     H     I     J     K     L     M     N     O
+  /* 40 */ 0x9F, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92,
+  //          P     Q     R     S     T     U     V     W     X     Y     Z     [     \     ]     ^     _
+  /* 50 */ 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x2F, 0x31, 0x30, 0xA3, 0xAD,
+  //          `     a     b     c     d     e     f     g     h     i     j     k     l     m     n     o
+  /* 60 */ 0x35, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12,
+  //          p     q     r     s     t     u     v     w     x     y     z     {     |     }     ~   DEL
+  /* 70 */ 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0xAF, 0xB1, 0xB0, 0xB2, 0x2A,
+};
+
+const char * const DO_DESC[] =
+{
+  /* 0 */ "Delete action",
+  /* 1 */ "Redisplay",
+  /* 2 */ "Calibrate report rate",
+  /* 3 */ "Show statistics",
+  /* 4 */ "", "", "", "", "", "", "", "", "", "",
+  /* E */ "Load program ",
+  /* F */ "Save as program ",
+};
+
+const char * const EXECUTE_DESC[] =
+{
+  /* 0 */ "Let W = ",
+  /* 1 */ "Get W from R",
+  /* 2 */ "Put W in R",
+  /* 3 */ "Compare W to ",
+  /* 4 */ "Compare W to R",
+  /* 5 */ "Say R",
+  /* 6 */ "Say in ",
+  /* 7 */ "Let W = W + ",
+  /* 8 */ "Let W = W - ",
+  /* 9 */ "Clear memory to ",
+  /* A */ "Let W = W + R",
+  /* B */ "Let W = W - R",
+  /* C */ "Let W = W x R",
+  /* D */ "Let W = W / R",
+  /* E */ "Wait ",
+  /* F */ "Wait ",
+};
+
+const char EXECUTE_OPERAND[] =
+{
+  /* 0 */ OPERAND_HEX,
+  /* 1 */ OPERAND_HEX,
+  /* 2 */ OPERAND_HEX,
+  /* 3 */ OPERAND_HEX,
+  /* 4 */ OPERAND_HEX,
+  /* 5 */ OPERAND_HEX,
+  /* 6 */ OPERAND_FORMAT,
+  /* 7 */ OPERAND_HEX,
+  /* 8 */ OPERAND_HEX,
+  /* 9 */ OPERAND_HEX,
+  /* A */ OPERAND_HEX,
+  /* B */ OPERAND_HEX,
+  /* C */ OPERAND_HEX,
+  /* D */ OPERAND_HEX,
+  /* E */ OPERAND_MS,
+  /* F */ OPERAND_SEC,
+};
+
+const char * const JUMP_DESC[] =
+{
+  /* 0 */ "Jump Relative",
+  /* 1 */ "Jump if Carry",
+  /* 2 */ "Jump if High",
+  /* 3 */ "Jump if High or Carry",
+  /* 4 */ "Jump if Low",
+  /* 5 */ "Jump if Low or Carry",
+  /* 6 */ "Jump if Not Zero or Carry",
+  /* 7 */ "Jump if Not Zero",
+  /* 8 */ "Jump if Zero",
+  /* 9 */ "Jump if Zero or Carry",
+  /* A */ "Jump if Not Low or Carry",
+  /* B */ "Jump if Not Low",
+  /* C */ "Jump if Zero or Low",
+  /* D */ "Jump if Not High",
+  /* E */ "Jump if Not Carry",
+  /* F */ "Jump",
+};
+
+const char JUMP_OPERAND[] =
+{
+  /* 0 */ OPERAND_SIGNED,
+  /* 1 */ OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS,
+  /* 6 */ OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS,
+  /* B */ OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS, OPERAND_ADDRESS,
+};
+
+const char * const REGISTER_DESC[] =
+{
+  /* 0 */ "Let X = ",
+  /* 1 */ "Get W from R(X+",
+  /* 2 */ "Put W in R(X+",
+  /* 3 */ "Let X = X + ",
+  /* 4 */ "Get X from R",
+  /* 5 */ "Put X in R",
+  /* 6 */ "Let W = W - 1, Jump if Not Zero",
+  /* 7 */ "Let X = X - 1, Jump if Not Zero",
+  /* 8 */ "Put W in RR",
+  /* 9 */ "Add W to RR",
+  /* A */ "Subtract W from RR",
+  /* B */ "Say RR",
+  /* C */ "", "", "", "",
+};
+
+const char REGISTER_OPERAND[] =
+{
+  /* 0 */ OPERAND_HEX,
+  /* 1 */ OPERAND_OFFSET,
+  /* 2 */ OPERAND_OFFSET,
+  /* 3 */ OPERAND_HEX,
+  /* 4 */ OPERAND_HEX,
+  /* 5 */ OPERAND_HEX,
+  /* 6 */ OPERAND_ADDRESS,
+  /* 7 */ OPERAND_ADDRESS,
+  /* 8 */ OPERAND_HEX,
+  /* 9 */ OPERAND_HEX,
+  /* A */ OPERAND_HEX,
+  /* B */ OPERAND_HEX,
+  /* C */ OPERAND_HEX, OPERAND_HEX, OPERAND_HEX, OPERAND_HEX,
+};
+
+const char * const CONTROL_DESC[] =
+{
+  /* 0 */ "Chain to program ",
+  /* 1 */ "Call",
+  /* 2 */ "Return",
+  /* 3 */ "", "", "", "", "", "", "", "", "", "", "", "", "",
+};
+
+const char CONTROL_OPERAND[] =
+{
+  /* 0 */ OPERAND_HEX,
+  /* 1 */ OPERAND_ADDRESS, OPERAND_NONE, OPERAND_HEX, OPERAND_HEX, OPERAND_HEX,
+  /* 6 */ OPERAND_HEX, OPERAND_HEX, OPERAND_HEX, OPERAND_HEX, OPERAND_HEX,
+  /* B */ OPERAND_HEX, OPERAND_HEX, OPERAND_HEX, OPERAND_HEX, OPERAND_HEX,
+};
@@ -32,7 +32,7 @@ FUNCTION - This is a programmable button on which you can record a sequence of
            back when you press it.
 
 FEATURES - 1. A single rotary encoder knob (with push switch) is the only input.
-           2. Can record and replay up to 127 keystrokes (or other "actions").
+           2. Can record and replay up to 125 keystrokes (or other "actions").
            3. Absolutely NO HOST DRIVERS required.
 
 PIN USAGE -                     PIC18F25K50
@@ -47,7 +47,7 @@ PIN USAGE -                     PIC18F25K50
             Ground     --- | VSS  8    21 RB0 | <--                    |
             n/c        --- | RA7  9    20 VDD | --- +5V
                        <-- | RA6  10   19 VSS | --- Ground
-                       <-- | RC0  11   18 RC7 | --> RX
+                       <-- | RC0  11   18 RC7 | --> SDO (25LC256 SI, if used)
                        <-- | RC1  12   17 RC6 | --> TX
                        <-- | RC2  13   16 RC5 | <-> USB D+
             2 x 100 nF --- | VUSB 14   15 RC4 | <-> USB D-
@@ -89,9 +89,9 @@ CONFIG    - The PIC18F25K50 configuration fuses should be set as follows (items
                               00 =  WDTEN: Watchdog Timer disabled in hardware, SWDTEN bit disabled
             CONFIG3L 00 00000000
                         00000000 =  Unimplemented
-            CONFIG3H 53 01010000
+            CONFIG3H 10 00010000
                         0        = *MCLRE: RE3 input pin enabled; MCLR disabled
-                         1       =  SDOMX: SDO is on RB3
+                         0       =  SDOMX: SDO is on RC7 (the 25LC256 SI pin, see storage.h)
                           0      =  Unimplemented
                            1     =  T3CMX: T3CKI is on RC0
                             00   =  Unimplemented
@@ -139,9 +139,9 @@ OPERATION - The user interacts with the system via a digital encoder knob with
               Set System Control function
               Set Consumer Device function
               Set Local Function (WAIT, GOTO etc)
-              Save to EEPROM
+              Save as program nn
               Redisplay
-              Reload from EEPROM
+              Load program nn
               Delete Action
 
             - Press the knob to select the desired function. For example,
@@ -164,10 +164,43 @@ OPERATION - The user interacts with the system via a digital encoder knob with
 
             - Press and hold the knob to return to the main menu.
 
-            - Rotate the knob to choose the "Save to EEPROM" function.
+            - Choose "Do Local Function", then press+turn the knob to choose
+              the "Save as program" function (and turn it to choose the
+              program number when there is room for more than one program).
 
             - Now when you press the knob the saved keystrokes will be replayed.
 
+            Programs are kept in the on-chip EEPROM (which saves at most 61
+            actions), or in the storage chosen by STORAGE in storage.h.
+            Only one program at a time is held in RAM: "Load program"
+            chooses the program that the knob plays, and "Chain to program"
+            loads another program while playing, which lets a macro run to
+            thousands of actions. The program that was pressed for is loaded
+            again when playing stops. Loading another program would lose any
+            edits not yet saved, so while there are any a Chain stops playing
+            instead: the LED flashes slowly, and PROGRAM mode shows "Save
+            before chaining at nn".
+
+            The display is kept up to date by typing into the text editor, so
+            the editor must treat these keys in the usual way:
+
+              HOME / END          Start / end of the current line
+              CTL+HOME / CTL+END  Start / end of the text
+              UP / DOWN           Previous / next line (staying in line 1 or
+                                  the last line when already there)
+              SHIFT+key           Extend the selection as the key moves
+              DELETE / BACKSPACE  Delete the selection, or the character
+                                  after / before the caret
+              ENTER               Start a new line
+
+            The device remembers where it left the caret, so clicking in or
+            typing into the editor while in PROGRAM mode can confuse the
+            display. Choose "Redisplay" to redraw it.
+
+            "Show statistics" types the number of reports, storage writes and
+            the time taken by the last macro played or local function done,
+            and the time the host needs to poll for that many reports.
+
 
 
 
@@ -206,71 +239,90 @@ HISTORY  - Date     Ver   By  Reason (most recent at the top please)
 #include <stdint.h>
 #include <built_in.h>
 #include "USBdsc.h"
+#include "actions.h"
+#include "usagetext.h"
 #include "pub.h"
+#include "storage.h"
 
-// Copies a text string from ROM into a RAM buffer (saves RAM)
-char * _TEXT(const char * p)
-{
-  static char sText[70];
-  char * q;
-  for (q=&sText; *q++ = *p++; );
-  return &sText;
-}
 
-const char * getKeyDescWithNoShift (uint8_t key) // Note: Literals returned as const are in ROM
-{ // Keyboard key without SHIFT modifier key pressed
-  if (key < ELEMENTS(UNSHIFTED_USB_DESC))
-  {
-    return UNSHIFTED_USB_DESC[key];
-  }
-  else
-  {
-    return "";
-  }
-}
 
-const char * getKeyDescWithShift(uint8_t key) // Note: Literals returned as const are in ROM
-{ // Keyboard key with SHIFT modifier key pressed
-  if (key < ELEMENTS(SHIFTED_USB_DESC))
-  {
-    return SHIFTED_USB_DESC[key];
-  }
-  else
+uint8_t findUsage(const uint16_t * pUsages, uint8_t nUsages, uint16_t usage)
+{
+  // Returns the index of the first named usage at or above usage (nUsages
+  // if there is none), by binary search of the ascending usage table
+  uint8_t nLow;
+  uint8_t nHigh;
+  uint8_t i;
+  nLow = 0;
+  nHigh = nUsages;
+  while (nLow < nHigh)
   {
-    return "";
+    i = (nLow + nHigh) / 2;
+    if (pUsages[i] < usage)
+      nLow = i + 1;
+    else
+      nHigh = i;
   }
+  return nLow;
 }
 
+uint16_t stepUsage(const uint16_t * pUsages, uint8_t nUsages, uint16_t usage, int8_t rotation)
+{
+  // Returns the named usage rotation places on from usage, wrapping round
+  // at either end of the table
+  int16_t i;
+  i = findUsage(pUsages, nUsages, usage);
+  if (rotation > 0 && (i == nUsages || pUsages[i] != usage))
+    i--;                                  // Usage has no name: count from the one below it
+  i += rotation;
+  while (i < 0)
+    i += nUsages;
+  while (i >= nUsages)
+    i -= nUsages;
+  return pUsages[i];
+}
 
-const char * getUsageDesc (t_action * pAction) // Note: Literals returned as const are in ROM
+uint16_t getUsageText (t_action * pAction)
 {
+  // Returns where the name of a keystroke, system control or consumer
+  // device usage starts in USAGE_TEXT (0, the empty name, if it has none)
+  uint8_t i;
   switch (pAction->key.page)
   {
     case PAGE_KEYBOARD:
       if (pAction->key.mod & MODIFIER_LEFTSHIFT)
       {
-        const char * pKeyDescWithShift = getKeyDescWithShift(pAction->key.usage);
-        if (*pKeyDescWithShift)
-          return pKeyDescWithShift;
+        if (pAction->key.usage < ELEMENTS(SHIFTED_USB_TEXT) && SHIFTED_USB_TEXT[pAction->key.usage])
+          return SHIFTED_USB_TEXT[pAction->key.usage];
       }
-      return getKeyDescWithNoShift(pAction->key.usage);
+      if (pAction->key.usage < ELEMENTS(UNSHIFTED_USB_TEXT))
+        return UNSHIFTED_USB_TEXT[pAction->key.usage];
+      return 0;
 
     case PAGE_SYSTEM_CONTROL:
-      if (pAction->sys.usage < ELEMENTS(SYSTEM_CONTROL_DESC))
-      {
-        return SYSTEM_CONTROL_DESC[pAction->sys.usage];
-      }
-      else
-        return "";
+      i = findUsage(SYSTEM_CONTROL_USAGE, ELEMENTS(SYSTEM_CONTROL_USAGE), pAction->sys.usage);
+      if (i < ELEMENTS(SYSTEM_CONTROL_USAGE) && SYSTEM_CONTROL_USAGE[i] == pAction->sys.usage)
+        return SYSTEM_CONTROL_TEXT[i];
+      return 0;
 
     case PAGE_CONSUMER_DEVICE:
-      if (pAction->cons.usage < ELEMENTS(CONSUMER_DEVICE_DESC))
-      {
-        return CONSUMER_DEVICE_DESC[pAction->cons.usage];
-      }
-      else
-        return "";
-//  case 0x30:     // Reserved
+      i = findUsage(CONSUMER_DEVICE_USAGE, ELEMENTS(CONSUMER_DEVICE_USAGE), pAction->cons.usage);
+      if (i < ELEMENTS(CONSUMER_DEVICE_USAGE) && CONSUMER_DEVICE_USAGE[i] == pAction->cons.usage)
+        return CONSUMER_DEVICE_TEXT[i];
+      return 0;
+
+    default:
+      return 0;
+  }
+}
+
+const char * getUsageDesc (t_action * pAction) // Note: Literals returned as const are in ROM
+{
+  switch (pAction->key.page)
+  {
+    case PAGE_TEXT:
+      return "Text, length ";
+
 //  case 0x40:     // Reserved
 //  case 0x50:     // Reserved
 //  case 0x60:     // Reserved
@@ -279,100 +331,21 @@ const char * getUsageDesc (t_action * pAction) // Note: Literals returned as con
 //  case 0x90:     // Reserved
 //  case 0xA0:     // Reserved
 //  case 0xB0:     // Reserved
-//  case 0xC0:     // Reserved
+
+    case PAGE_REGISTER:
+      return REGISTER_DESC[pAction->key.mod];
+
+    case PAGE_CONTROL:
+      return CONTROL_DESC[pAction->key.mod];
 
     case PAGE_DO:
-      switch (pAction->key.mod)
-      {
-        case DO_DELETE:
-          return "Delete action";
-        case DO_LOAD:
-          return "Load from EEPROM";
-        case DO_SAVE:
-          return "Save to EEPROM";
-        case DO_REDISPLAY:
-          return "Redisplay";
-        default:
-          return "";
-      }
+      return DO_DESC[pAction->key.mod];
 
     case PAGE_EXECUTE:
-      switch (pAction->key.mod)
-      {
-        case EXECUTE_SET:
-          return "Let W = ";
-        case EXECUTE_GET:
-          return "Get W from R";
-        case EXECUTE_PUT:
-          return "Put W in R";
-        case EXECUTE_COMPARE_IMMEDIATE:
-          return "Compare W to ";
-        case EXECUTE_COMPARE:
-          return "Compare W to R";
-        case EXECUTE_SAY:
-          return "Say R";
-        case EXECUTE_FORMAT:
-          return "Say in ";
-        case EXECUTE_ADD_IMMEDIATE:
-          return "Let W = W + ";
-        case EXECUTE_SUB_IMMEDIATE:
-          return "Let W = W - ";
-        case EXECUTE_CLEAR:
-          return "Clear memory to ";
-        case EXECUTE_ADD:
-          return "Let W = W + R";
-        case EXECUTE_SUB:
-          return "Let W = W - R";
-        case EXECUTE_MUL:
-          return "Let W = W x R";
-        case EXECUTE_DIV:
-          return "Let W = W / R";
-        case EXECUTE_WAIT_MS:
-          return "Wait "; // milliseconds
-        case EXECUTE_WAIT_SEC:
-          return "Wait "; // seconds
-        default:
-          return "";
-      }
+      return EXECUTE_DESC[pAction->key.mod];
 
     case PAGE_JUMP:
-      switch (pAction->key.mod)
-      {
-        case JUMP_RELATIVE:
-          return "Jump Relative";
-        case JUMP_IF_CARRY:
-          return "Jump if Carry";
-        case JUMP_IF_HIGH:
-          return "Jump if High";
-        case JUMP_IF_HIGH_OR_CARRY:
-          return "Jump if High or Carry";
-        case JUMP_IF_LOW:
-          return "Jump if Low";
-        case JUMP_IF_LOW_OR_CARRY:
-          return "Jump if Low or Carry";
-        case JUMP_IF_NOT_ZERO_OR_CARRY:
-          return "Jump if Not Zero or Carry";
-        case JUMP_IF_NOT_ZERO:
-          return "Jump if Not Zero";
-        case JUMP_IF_ZERO:
-          return "Jump if Zero";
-        case JUMP_IF_ZERO_OR_CARRY:
-          return "Jump if Zero or Carry";
-        case JUMP_IF_NOT_LOW_OR_CARRY:
-          return "Jump if Not Low or Carry";
-        case JUMP_IF_NOT_LOW:
-          return "Jump if Not Low";
-        case JUMP_IF_ZERO_OR_LOW:
-          return "Jump if Zero or Low";
-        case JUMP_IF_NOT_HIGH:
-          return "Jump if Not High";
-        case JUMP_IF_NOT_CARRY:
-          return "Jump if Not Carry";
-        case JUMP:
-          return "Jump";
-        default:
-          break;
-      }
+      return JUMP_DESC[pAction->key.mod];
 
     default:
       return "";
@@ -387,9 +360,9 @@ void toPrintableHex(uint8_t c, char * p)
   *p   = '\0';
 }
 
-void adjustShiftModifier ()
+uint8_t adjustShiftModifier (uint8_t modifiers, uint8_t key)
 {
-  if (usbToHost[3] >= USB_KEY_A && usbToHost[3] <= USB_KEY_Z)  // Handle SHIFT for alphabetics
+  if (key >= USB_KEY_A && key <= USB_KEY_Z)  // Handle SHIFT for alphabetics
   {
     // If the user wants SHIFT+A to be sent to the host, then it is reasonable
     // to expect it to be interpreted by the host as an uppercase "A". But, if
@@ -408,104 +381,368 @@ void adjustShiftModifier ()
     //     1           1               0             A
     // This is a classic Exclusive-OR truth table, from which we can code:
 
-    if ((usbToHost[1] & SHIFT) != leds.bits.CapsLock) // Logical Exclusive-OR
-      usbToHost[1] |= SHIFT;              // SHIFT modifier bit = 1
+    if ((modifiers & SHIFT) != leds.bits.CapsLock) // Logical Exclusive-OR
+      modifiers |= SHIFT;                 // SHIFT modifier bit = 1
     else
-      usbToHost[1] &= ~SHIFT;             // SHIFT modifier bit = 0
+      modifiers &= ~SHIFT;                // SHIFT modifier bit = 0
+  }
+  return modifiers;
+}
+
+uint8_t isKeyIn(t_keyboardReport * pReport, uint8_t key)
+{
+  uint8_t i;
+  for (i = 0; i < pReport->nKeys; i++)
+  {
+    if (pReport->key[i] == key)
+      return TRUE;
   }
+  return FALSE;
 }
 
+uint16_t getTicks()
+{
+  uint16_t nTicks;
+  TMR3IE_bit = 0;                         // Keep the tick interrupt from changing the count
+  nTicks = nTickCount;                    // while its two bytes are read
+  TMR3IE_bit = 1;
+  return nTicks;
+}
 
-void playSystemControlCommand(t_action * pAction)
+void idle()
 {
-  if (!bUSBReady) return;
-  usbToHost[0] = REPORT_ID_SYSTEM_CONTROL;  // Report Id = System Control
-  usbToHost[1] = pAction->sys.usage;        // Function requested
-  while(!HID_Write(&usbToHost, 2));         // Copy to USB buffer and try to send
-  usbToHost[1] = 0;                         // No function requested anymore
-  while(!HID_Write(&usbToHost, 2));         // Copy to USB buffer and try to send
+  // Stops the CPU until the next interrupt: the knob, the millisecond tick,
+  // or the USB module (which keeps running because IDLEN is set)
+  asm sleep;
 }
 
-void playConsumerDeviceCommand(t_action * pAction)
+uint8_t isReportDue()
+{
+  // The host polls once every nReportMs (see calibrateReportRate), so the
+  // endpoint cannot take another report until nearly that long after the
+  // last. The tick and the polls are not in step, hence the millisecond off
+  return (uint16_t)(getTicks() - nLastReportTick) >= (uint16_t)(nReportMs - 1);
+}
+
+void sendReports()
+{
+  // Reports are sent from the queue whenever the endpoint is ready for the
+  // next one, so callers never have to wait for the host to poll for them.
+  while (nReportHead != nReportTail && isReportDue() &&
+         HID_Write(reportQueue[nReportHead].data, reportQueue[nReportHead].len)) // Copy to USB buffer and try to send
+  {
+    nReportHead = (nReportHead + 1) & (REPORT_QUEUE_SIZE - 1);
+    nLastReportTick = getTicks();
+    stats.nReports++;
+  }
+}
+
+void awaitReport()
+{
+  // Sends what it can, then idles if the host will not take a report
+  // before the next tick
+  sendReports();
+  if (nReportHead != nReportTail && !isReportDue())
+    idle();
+}
+
+void waitForReports()
+{
+  while (nReportHead != nReportTail)  // Until the host has taken every queued report
+  {
+    awaitReport();
+  }
+}
+
+uint8_t * newReport(uint8_t len)
+{
+  // The slot just sent may still be in transit, so the queue is full while
+  // only one free slot remains.
+  while (((nReportTail + 1) & (REPORT_QUEUE_SIZE - 1)) == nReportHead) // While the queue is full
+  {
+    awaitReport();                    // Wait for the host to take a report
+  }
+  reportQueue[nReportTail].len = len;
+  return reportQueue[nReportTail].data;
+}
+
+void queueReport()
 {
+  nReportTail = (nReportTail + 1) & (REPORT_QUEUE_SIZE - 1);
+  sendReports();                      // Send it now if the endpoint is ready
+}
+
+void sendKeyboardReport(t_keyboardReport * pReport)
+{
+  uint8_t i;
+  uint8_t * p;
   if (!bUSBReady) return;
-  usbToHost[0] = REPORT_ID_CONSUMER_DEVICE; // Report Id = Consumer Device
-  usbToHost[1] = pAction->cons.usage;       // Function requested (low byte)
-  usbToHost[2] = pAction->cons.usage >> 8;  // Function requested (high byte)
-  while(!HID_Write(&usbToHost, 3));         // Copy to USB buffer and try to send
-  usbToHost[1] = 0;                         // Function requested low byte
-  usbToHost[2] = 0;                         // Function requested high byte
-  while(!HID_Write(&usbToHost, 3));         // Copy to USB buffer and try to send
+  p = newReport(1+2+MAX_KEYS);
+  p[0] = REPORT_ID_KEYBOARD;                // Report Id = Keyboard
+  p[1] = pReport->modifiers;                // Ctrl/Alt/Shift modifiers
+  p[2] = 0;                                 // Reserved for OEM
+  for (i = 0; i < MAX_KEYS; i++)            // Keys pressed
+  {
+    p[3+i] = i < pReport->nKeys ? pReport->key[i] : 0;
+  }
+  queueReport();
+}
+
+void releaseKeys()
+{
+  pressedKeys.modifiers = 0;                // No modifiers now
+  pressedKeys.nKeys = 0;                    // No keys pressed now
+  sendKeyboardReport(&pressedKeys);
+}
+
+void flushKeystrokes()
+{
+  uint8_t i;
+  if (!pendingKeys.nKeys) return;           // Nothing waiting to be sent
+  for (i = 0; i < pendingKeys.nKeys; i++)
+  {
+    if (isKeyIn(&pressedKeys, pendingKeys.key[i])) // If the host still sees this key as pressed
+    {
+      releaseKeys();                        // Release it first, else the host will not see a new key press
+      break;
+    }
+  }
+  pressedKeys = pendingKeys;                // Keys that are not pressed again are released by this report
+  sendKeyboardReport(&pressedKeys);
+  pendingKeys.nKeys = 0;
 }
 
 void sayNoKeyPressed()
 {
-  usbToHost[0] = REPORT_ID_KEYBOARD;        // Report Id = Keyboard
-  usbToHost[1] = 0;                         // No modifiers now
-  usbToHost[3] = 0;                         // No key pressed now
-  while(!HID_Write(&usbToHost, 4));         // Copy to USB buffer and try to send
+  if (nKeystrokeBatch) return;              // Keys are released at the end of the batch
+  flushKeystrokes();                        // Send any keys still waiting to be sent
+  if (pressedKeys.modifiers || pressedKeys.nKeys) // If the host sees anything as pressed
+  {
+    releaseKeys();                          // Release key otherwise the host will think it is still being pressed
+  }
+}
+
+void pressKey(uint8_t modifiers, uint8_t key)
+{
+  // The HID spec does not say in what order a host handles the keys that a
+  // report presses together, so two keys may only share a report if typing
+  // them in either order has the same effect. No two keys that are typed
+  // into an editor do ("ab" is not "ba"), so each report presses one new
+  // key. What is guaranteed is that it releases the key the report before
+  // pressed (a release and a press do commute), so typing still takes one
+  // report per key rather than two, except that a key typed twice running
+  // needs a report in between to release it.
+  modifiers = adjustShiftModifier(modifiers, key);
+  if (key == 0)                             // If only modifiers are being pressed
+  {
+    flushKeystrokes();                      // Send the keys collected so far
+    pressedKeys.modifiers = modifiers;
+    pressedKeys.nKeys = 0;
+    sendKeyboardReport(&pressedKeys);
+    return;
+  }
+  flushKeystrokes();                        // Send the key before this one
+  pendingKeys.modifiers = modifiers;
+  pendingKeys.key[pendingKeys.nKeys++] = key;
+}
+
+
+void beginKeystrokes()
+{
+  // Within a batch, a key is released by the report that presses the next
+  // one, rather than by a report of its own.
+  nKeystrokeBatch++;
+}
+
+void endKeystrokes()
+{
+  if (nKeystrokeBatch)
+    nKeystrokeBatch--;
+  sayNoKeyPressed();                        // Release everything at the end of the outermost batch
+}
+
+
+void playSystemControlCommand(t_action * pAction)
+{
+  uint8_t * p;
+  if (!bUSBReady) return;
+  flushKeystrokes();                        // Keep keystrokes and commands in order
+  p = newReport(2);
+  p[0] = REPORT_ID_SYSTEM_CONTROL;          // Report Id = System Control
+  p[1] = pAction->sys.usage;                // Function requested
+  queueReport();
+  p = newReport(2);
+  p[0] = REPORT_ID_SYSTEM_CONTROL;          // Report Id = System Control
+  p[1] = 0;                                 // No function requested anymore
+  queueReport();
+}
+
+void playConsumerDeviceCommand(t_action * pAction)
+{
+  uint8_t * p;
+  if (!bUSBReady) return;
+  flushKeystrokes();                        // Keep keystrokes and commands in order
+  p = newReport(3);
+  p[0] = REPORT_ID_CONSUMER_DEVICE;         // Report Id = Consumer Device
+  p[1] = pAction->cons.usage;               // Function requested (low byte)
+  p[2] = pAction->cons.usage >> 8;          // Function requested (high byte)
+  queueReport();
+  p = newReport(3);
+  p[0] = REPORT_ID_CONSUMER_DEVICE;         // Report Id = Consumer Device
+  p[1] = 0;                                 // Function requested low byte
+  p[2] = 0;                                 // Function requested high byte
+  queueReport();
 }
 
 void playKeystroke(t_action * pAction)
 {
   if (!bUSBReady) return;
-  if (usbToHost[0] == REPORT_ID_KEYBOARD && // If new keystroke is the same as the last one
-      usbToHost[1] == pAction->key.mod   &&
-      usbToHost[3] == pAction->key.usage)
+  pressKey(pAction->key.mod, pAction->key.usage); // Ctrl/Alt/Shift modifiers and key
+}
+
+void typeChar(uint8_t c)
+{
+  if (c < sizeof(ASCII_to_USB))
+  {
+    c = ASCII_to_USB[c]; // Top bit on means capitalise with Left Shift
+  }
+  else
+  {
+    c = SPACE; // Replace invalid ASCII character with a space
+  }
+  if (c & 0b10000000) // If SHIFT key needed
+  {
+    pressKey(SHIFT, c & 0b01111111);
+  }
+  else
   {
-    sayNoKeyPressed();                      // Release the key before sending it again
+    pressKey(NONE, c);
   }
-  usbToHost[0] = REPORT_ID_KEYBOARD;        // Report Id = Keyboard
-  usbToHost[1] = pAction->key.mod;          // Ctrl/Alt/Shift modifiers
-  usbToHost[2] = 0;                         // Reserved for OEM
-  usbToHost[3] = pAction->key.usage;        // Key pressed
-  adjustShiftModifier();                    // Adjust SHIFT for alphabetics
-  while(!HID_Write(&usbToHost, 4));         // Copy to USB buffer and try to send
-  usbToHost[1] = pAction->key.mod;          // Reset modifiers to what was requested
 }
 
-void say(uint8_t * p)
+uint8_t playText(uint8_t pc)
 {
-  uint8_t c;
-  t_action action;
+  // Types the characters of the text run at pc, and returns the number of
+  // actions that hold them
+  t_action * p;
+  uint8_t nLength;
+  uint8_t i;
 
-  while (*p)
+  nLength = aAction[pc].key.usage;
+  if (pc + 1 + TEXT_SLOTS(nLength) > nAction) // If the run is cut short
+    nLength = (nAction - pc - 1) * 2;
+  if (!bUSBReady) return TEXT_SLOTS(nLength);
+  p = &aAction[pc+1];
+  for (i = 0; i < nLength; i++)
   {
-    if (*p < sizeof(ASCII_to_USB))
-    {
-      c = ASCII_to_USB[*p]; // Top bit on means capitalise with Left Shift
-    }
-    else
-    {
-      c = SPACE; // Replace invalid ASCII character with a space
-    }
-    if (c & 0b10000000) // If SHIFT key needed
+    if (i & 1)
     {
-      action.key.mod = MODIFIER_LEFTSHIFT;
-      action.key.usage = c & 0b01111111;
+      typeChar(Lo(p->action));
+      p++;
     }
     else
     {
-      action.key.mod = 0;
-      action.key.usage = c;
+      typeChar(Hi(p->action));
     }
-    playKeystroke(&action);
-    p++;
   }
+  return TEXT_SLOTS(nLength);
+}
+
+void sayOneChar(uint8_t c)
+{
+  typeChar(c);
+  if (nCaretColumn != COLUMN_UNKNOWN)
+    nCaretColumn++;
+}
+
+uint8_t getSourceChar(t_source * pSource)
+{
+  // Returns the next character from pSource, or 0 at the end
+  uint8_t c;
+  switch (pSource->type)
+  {
+    case SOURCE_RAM:
+      c = *pSource->pRam;
+      if (c)
+        pSource->pRam++;
+      return c;
+
+    case SOURCE_ROM:
+      c = *pSource->pRom;
+      if (c)
+        pSource->pRom++;
+      return c;
+
+    case SOURCE_USAGE:
+      if (pSource->pToken && *pSource->pToken)
+        return *pSource->pToken++;
+      c = *pSource->pRom;
+      if (!c)
+        return 0;
+      pSource->pRom++;
+      if (c & 0x80)  // A token: a fragment (never empty) stored elsewhere in the pool
+      {
+        pSource->pToken = &USAGE_TEXT[USAGE_TOKEN[c & 0x7F]];
+        return *pSource->pToken++;
+      }
+      return c;
+
+    default:
+      return 0;
+  }
+}
+
+void sayFrom(t_source * pSource)
+{
+  uint8_t c;
+  while ((c = getSourceChar(pSource)) != 0)
+    sayOneChar(c);
   sayNoKeyPressed(); // Release key otherwise the host will think the last key is still being pressed
 }
 
-void sayConst(const uint8_t * p)
+void say(char * p)
 {
-  say(_TEXT(p));
+  t_source source;
+  source.type = SOURCE_RAM;
+  source.pRam = (uint8_t *)p;
+  sayFrom(&source);
+}
+
+void sayConst(const char * p)
+{
+  t_source source;
+  source.type = SOURCE_ROM;
+  source.pRom = (const uint8_t *)p;
+  sayFrom(&source);
+}
+
+void sayUsageText(uint16_t offset)
+{
+  // Types a name from the packed pool in usagetext.h
+  t_source source;
+  source.type = SOURCE_USAGE;
+  source.pRom = &USAGE_TEXT[offset];
+  source.pToken = 0;
+  sayFrom(&source);
+}
+
+void sayWord(uint16_t w)
+{
+  char * p;
+  char sString[6]; // "nnnnn"
+  WordToStr(w, sString);
+  for (p=sString; *p == ' '; p++);  // Find first non-blank
+  say(p);
 }
 
 void sayModifiers(t_keyboardAction * pAction)
 {
-  if (pAction->mod & MODIFIER_LEFTGUI)     sayConst("GUI+");
-  if (pAction->mod & MODIFIER_LEFTCTL)     sayConst("CTL+");
-  if (pAction->mod & MODIFIER_LEFTALT)     sayConst("ALT+");
-  if (pAction->mod & MODIFIER_LEFTSHIFT)   sayConst("SHIFT+");
+  uint8_t i;
+  for (i = 0; i < ELEMENTS(MODIFIER_ORDER); i++)
+  {
+    if (pAction->mod & MODIFIER_ORDER[i])
+      sayConst(MODIFIER_DESC[i]);
+  }
 }
 
 void sayChar(uint8_t c)
@@ -527,30 +764,189 @@ void sayDec(uint8_t c)
 {
   char * p;
   char sString[4]; // "nnn"
-  ByteToStr(c, &sString);
-  for (p=&sString; *p == ' '; p++);  // Find first non-blank
+  ByteToStr(c, sString);
+  for (p=sString; *p == ' '; p++);  // Find first non-blank
   say(p);
 }
 
 void saySignedDec(int8_t c)
 {
   char * p;
-  char sString[4]; // "nnn"
-  ShortToStr(c, &sString);
-  for (p=&sString; *p == ' '; p++);  // Find first non-blank
+  char sString[5]; // "-nnn"
+  ShortToStr(c, sString);
+  for (p=sString; *p == ' '; p++);  // Find first non-blank
   say(p);
 }
 
+uint8_t getLastLine()
+{
+  return START_ACTIONS_LINE - 1 + nShownActions;
+}
+
 void sayKey(uint8_t modifiers, uint8_t key)
 {
   if (!bUSBReady) return;
-  usbToHost[0] = REPORT_ID_KEYBOARD;      // Report Id = Keyboard
-  usbToHost[1] = modifiers;               // Ctrl/Alt/Shift modifiers
-  usbToHost[2] = 0;                       // Reserved for OEM
-  usbToHost[3] = key;                     // Key pressed
-  adjustShiftModifier();                  // Adjust SHIFT for alphabetics
-  while(!HID_Write(&usbToHost, 4));       // Copy to USB buffer and try to send
+  pressKey(modifiers, key);               // Ctrl/Alt/Shift modifiers and key
   sayNoKeyPressed();                      // Release key
+  switch (key)                            // Keep track of where the text editor caret is
+  {
+    case HOME:
+      if (modifiers & CTL)
+        nCaretLine = 1;
+      nCaretColumn = 0;
+      break;
+    case END:
+      if (modifiers & CTL)
+        nCaretLine = getLastLine();
+      nCaretColumn = COLUMN_UNKNOWN;
+      break;
+    case ENTER:
+      if (nCaretLine)
+        nCaretLine++;
+      nCaretColumn = 0;
+      break;
+    case DOWN:
+      if (nCaretLine && nCaretLine < getLastLine())
+        nCaretLine++;
+      if (nCaretColumn)                   // The caret stays at the start of a line
+        nCaretColumn = COLUMN_UNKNOWN;
+      break;
+    case UP:
+      if (nCaretLine > 1)
+        nCaretLine--;
+      if (nCaretColumn)
+        nCaretColumn = COLUMN_UNKNOWN;
+      break;
+    case SPACE:
+      if (nCaretColumn != COLUMN_UNKNOWN)
+        nCaretColumn++;
+      break;
+    default:
+      nCaretColumn = COLUMN_UNKNOWN;
+      break;
+  }
+  if (modifiers & SHIFT)                  // Text is selected, so the caret must be
+    nCaretColumn = COLUMN_UNKNOWN;        // moved without SHIFT to drop the selection
+}
+
+uint16_t getTimer3()
+{
+  uint16_t t;
+  Lo(t) = TMR3L;                          // Reading TMR3L also latches TMR3H (RD16=1)
+  Hi(t) = TMR3H;
+  return t;
+}
+
+uint8_t isDue(uint16_t deadline)
+{
+  return (int16_t)(getTicks() - deadline) >= 0;  // Deadlines must be within 32 seconds
+}
+
+void parkUntil(uint16_t deadline, uint8_t bInterruptible)
+{
+  // Keeps the reports going out to the host until the deadline, instead of
+  // spinning in Delay_ms. The button and knob are serviced by interrupts
+  // meanwhile, and a press ends an interruptible wait early
+  while (!isDue(deadline) && !(bInterruptible && bUserInterrupt))
+  {
+    sendReports();
+    if (nReportHead == nReportTail || !isReportDue()) // Nothing to do until the next tick
+      idle();
+  }
+}
+
+void pause(uint8_t nMilliseconds)
+{
+  parkUntil(getTicks() + nMilliseconds + 1, FALSE); // +1 because the current millisecond is partly gone
+}
+
+void startTimer(uint16_t nTicks)
+{
+  nTimerDeadline = getTicks() + nTicks;
+  bTimerRunning = TRUE;
+}
+
+void stopTimer()
+{
+  bTimerRunning = FALSE;
+}
+
+uint8_t isTimerExpired()
+{
+  return bTimerRunning && isDue(nTimerDeadline);
+}
+
+void calibrateReportRate()
+{
+  uint8_t i;
+  uint16_t t;
+  uint16_t tLast;
+
+  // Each report is held by the endpoint until the host polls for it, so
+  // the time between successive reports being accepted is the fastest rate
+  // the host will really take them at, whatever the descriptor asks for.
+  // The slowest of several samples is kept, and sendReports() then leaves
+  // that long between reports, idling instead of offering them sooner
+  if (!bUSBReady) return;
+  waitForReports();
+  nReportMs = 1;                          // Offer each sample as soon as the endpoint is free
+  tLast = getTicks();
+  for (i = 0; i <= 8; i++)
+  {
+    releaseKeys();                        // Send an empty keyboard report
+    waitForReports();                     // Wait until the endpoint has accepted it
+    t = getTicks();
+    if (i && t - tLast > nReportMs)       // First sample only synchronises with the host
+      nReportMs = t - tLast;
+    tLast = t;
+  }
+}
+
+void sayReportRate()
+{
+  sayWord(nReportMs);
+  sayConst(" ms per report");
+}
+
+void beginMeasurement()
+{
+  TMR3IE_bit = 0;                         // Keep the timer interrupt from updating the counts
+  stats.nReports = 0;
+  stats.nStorageWrites = 0;
+  stats.nMs = 0;
+  TMR3IE_bit = 1;
+}
+
+void endMeasurement()
+{
+  waitForReports();                       // Count every report the operation queued
+  TMR3IE_bit = 0;
+  lastStats = stats;
+  TMR3IE_bit = 1;
+}
+
+void sayStatistics()
+{
+  uint32_t nTenths;
+  sayWord(lastStats.nReports);
+  sayConst(" reports, ");
+  sayWord(lastStats.nStorageWrites);
+  sayConst(" storage writes, ");
+  nTenths = lastStats.nMs / 100;
+  if (nTenths > 655359)                   // Longer than sayWord() can say (over 18 hours)
+    nTenths = 655359;
+  sayWord(nTenths / 10);
+  sayChar('.');
+  sayDec(nTenths % 10);
+  sayConst(" s, ");
+  // The time the host alone needs to poll for that many reports at the
+  // calibrated rate. This is the least the operation could have taken.
+  nTenths = (uint32_t)lastStats.nReports * nReportMs / 100;
+  sayWord(nTenths / 10);
+  sayChar('.');
+  sayDec(nTenths % 10);
+  sayConst(" s at ");
+  sayReportRate();
 }
 
 void enableUSB()
@@ -558,9 +954,15 @@ void enableUSB()
   uint8_t i;
 
   usbToHost[0] = REPORT_ID_KEYBOARD;     // Report Id = Keyboard
-  usbToHost[1] = 0;                      // No modifiers
-  usbToHost[2] = 0;                      // Reserved for OEM
-  usbToHost[3] = 0;                      // No key pressed
+  for (i = 1; i < sizeof(usbToHost); i++)
+  {
+    usbToHost[i] = 0;                    // No modifiers and no keys pressed
+  }
+  pendingKeys.nKeys = 0;
+  pressedKeys.modifiers = 0;
+  pressedKeys.nKeys = 0;
+  nReportHead = 0;                       // Discard any unsent reports
+  nReportTail = 0;
   bUSBReady = FALSE;
   while (!bUSBReady)
   {
@@ -569,7 +971,7 @@ void enableUSB()
     {
       Delay_ms(100);
       ACTIVITY_LED = ON;                         // LED will be turned off by the next timer interrupt
-      bUSBReady = HID_Write(&usbToHost, 4) != 0; // Copy to USB buffer and try to send
+      bUSBReady = HID_Write(&usbToHost, 1+2+MAX_KEYS) != 0; // Send an empty keyboard report
     }
     if (!bUSBReady)
     {
@@ -578,6 +980,7 @@ void enableUSB()
     }
   }
   Delay_ms(250);
+  calibrateReportRate();                 // Measure how fast this host takes reports
 }
 
 void disableUSB()
@@ -591,42 +994,162 @@ void wait()
   Delay_ms(20);
 }
 
-void saveInEEPROM()
+void setDirty(uint8_t n)
+{
+  aDirty[n >> 3] |= 1 << (n & 7);
+}
+
+void setAllBits(uint8_t * pBits, uint8_t bOn)
+{
+  uint8_t i;
+  for (i = 0; i < sizeof(aDirty); i++)
+  {
+    *pBits++ = bOn ? 0xFF : 0x00;
+  }
+}
+
+uint8_t isAnyBitSet(uint8_t * pBits)
+{
+  uint8_t i;
+  for (i = 0; i < sizeof(aDirty); i++)
+  {
+    if (*pBits++)
+      return TRUE;
+  }
+  return FALSE;
+}
+
+uint8_t findProgram(uint8_t n)
+{
+  // Finds the newest whole copy of program n, and returns FALSE if there
+  // is none
+  int8_t nNewest;
+  nProgram = n;
+  nNewest = findNewestCopy(n);
+  if (nNewest < 0)
+  {
+    nCopy = 1;                            // So that the first save is to copy 0
+    nSequence = 0;
+    return FALSE;
+  }
+  nCopy = nNewest;
+  nSequence = storageRead(getCopyAddress(n, nCopy, 1));
+  return TRUE;
+}
+
+uint16_t saveRecordByte(uint8_t offset, uint8_t b, uint16_t crc)
 {
+  storageWrite(getCopyAddress(nProgram, nCopy, offset), b);
+  return updateCRC(crc, b);
+}
+
+uint8_t saveProgram(uint8_t n)
+{
+  // Overwrites the older copy of the program. Only the actions that copy
+  // lacks are written, so the time taken depends on the size of the edit.
+  // Returns FALSE, having written nothing, if the program has more actions
+  // than a copy holds (see MAX_SAVED_ACTIONS)
   t_action * p;
-  uint8_t addr;
-  uint8_t  i;
+  uint16_t crc;
+  uint8_t offset;
+  uint8_t i;
 
-  EEPROM_Write(0, nActionFocus);   // Save currently focussed action in byte 0
-  EEPROM_Write(1, nAction);        // Save number of actions
+  if (nAction > MAX_SAVED_ACTIONS)
+    return FALSE;
+  if (n != nProgram)                      // If saving as another program
+  {
+    findProgram(n);
+    setAllBits(aDirty, TRUE);             // Every action must be written
+  }
+  nCopy ^= 1;
+  nSequence++;
+  crc = saveRecordByte(0, RECORD_VERSION, 0xFFFF);
+  crc = saveRecordByte(1, nSequence, crc);
+  crc = saveRecordByte(2, nActionFocus, crc);
+  crc = saveRecordByte(3, nAction, crc);
   p = &aAction[0];
-  addr = 2;
-  for (i = 0; i < nAction; i++, p++)
+  for (i = 0, offset = 4; i < nAction; i++, p++, offset += 2)
   {
-    EEPROM_Write(addr++, Hi(p->action));
-    EEPROM_Write(addr++, Lo(p->action));
+    if ((aDirty[i >> 3] | aStale[i >> 3]) & (1 << (i & 7)))
+    {
+      crc = saveRecordByte(offset, Hi(p->action), crc);
+      crc = saveRecordByte(offset+1, Lo(p->action), crc);
+    }
+    else                                  // The copy already has this action
+    {
+      crc = updateCRC(updateCRC(crc, Hi(p->action)), Lo(p->action));
+    }
   }
+  storageWrite(getCopyAddress(n, nCopy, offset), Hi(crc)); // The CRC goes last, so that
+  storageWrite(getCopyAddress(n, nCopy, offset+1), Lo(crc)); // a torn save is never whole
+  storageFlush();
+  for (i = 0; i < sizeof(aDirty); i++)
+  {
+    aStale[i] = aDirty[i];                // The other copy now lacks just this edit
+    aDirty[i] = 0;
+  }
+  return TRUE;
 }
 
-void loadFromEEPROM()
+#if STORAGE == STORAGE_EEPROM
+void loadLegacyProgram()
 {
+  // Reads a program in the layout of firmware 0.93 and before (see
+  // isLegacyProgram). Its last actions are lost if it has more than fit now.
   t_action * p;
   uint8_t addr;
-  uint8_t  i;
+  uint8_t i;
 
-  // Read any actions present in the EEPROM
-  nActionFocus = EEPROM_Read(0);          // Read currently focussed action
-  if (nActionFocus > ELEMENTS(aAction))   // If EEPROM empty, or number of actions invalid
-    nActionFocus = 0;                     // Assume content of EEPROM is NBG
-  nAction = EEPROM_Read(1);               // Read number of actions
-  if (nAction > ELEMENTS(aAction))        // If EEPROM empty, or number of actions invalid
-    nAction = 0;                          // Assume content of EEPROM is NBG
+  nAction = storageRead(1);
+  if (nAction > ELEMENTS(aAction))
+    nAction = ELEMENTS(aAction);
+  nActionFocus = storageRead(0);
+  if (nActionFocus > nAction)
+    nActionFocus = nAction;
+  p = &aAction[0];
+  for (i = 0, addr = 2; i < nAction; i++, p++, addr += 2)
+  {
+    Hi(p->action) = storageRead(addr);
+    Lo(p->action) = storageRead(addr+1);
+  }
+  for (; i < ELEMENTS(aAction); i++, p++)
+  {
+    p->action = 0;
+  }
+}
+#endif
+
+void loadProgram(uint8_t n)
+{
+  t_action * p;
+  uint8_t offset;
+  uint8_t i;
+
+  // Read the newest whole copy of the program in the storage
+  setAllBits(aDirty, FALSE);
+  setAllBits(aStale, TRUE);               // Nothing is known about the other copy
+  nActionFocus = 0;
+  nAction = 0;
+  if (findProgram(n))
+  {
+    nActionFocus = storageRead(getCopyAddress(n, nCopy, 2));
+    nAction = storageRead(getCopyAddress(n, nCopy, 3));
+    if (nActionFocus > nAction)
+      nActionFocus = 0;
+  }
+#if STORAGE == STORAGE_EEPROM
+  else if (isLegacyProgram())             // Saved by 0.93 or before: import it once. The
+  {                                       // next save replaces it with a record (copy 0)
+    loadLegacyProgram();
+    return;
+  }
+#endif
 
   p = &aAction[0];          // Point to the first element of the actions array
-  for (addr = 2, i = 0; i < nAction; i++)
+  for (i = 0, offset = 4; i < nAction; i++, offset += 2)
   {
-    Hi(p->action) = EEPROM_Read(addr++);
-    Lo(p->action) = EEPROM_Read(addr++);
+    Hi(p->action) = storageRead(getCopyAddress(n, nCopy, offset));
+    Lo(p->action) = storageRead(getCopyAddress(n, nCopy, offset+1));
     p++;
   }
   // Clear any unused actions to zero
@@ -637,6 +1160,113 @@ void loadFromEEPROM()
 
 }
 
+uint8_t getImageByte(uint8_t addr)
+{
+  // The program image is 256 bytes: the focussed action, the number of
+  // actions, then each action (high byte first), padded with zeros.
+  t_action * p;
+  if (addr == 0) return nActionFocus;
+  if (addr == 1) return nAction;
+  if ((addr - 2) >> 1 >= ELEMENTS(aAction)) return 0;
+  p = &aAction[(addr - 2) >> 1];
+  return addr & 1 ? Lo(p->action) : Hi(p->action);
+}
+
+uint8_t setImageByte(uint8_t addr, uint8_t b)
+{
+  t_action * p;
+  if (addr < 2)
+  {
+    if (b > ELEMENTS(aAction))            // If the count is invalid
+      return FALSE;                       // Leave it unchanged
+    if (addr == 0)
+      nActionFocus = b;
+    else
+      nAction = b;
+    return TRUE;
+  }
+  if ((addr - 2) >> 1 >= ELEMENTS(aAction)) // If past the last action
+    return b == 0;                        // Only the padding is valid
+  p = &aAction[(addr - 2) >> 1];
+  if (addr & 1)
+    Lo(p->action) = b;
+  else
+    Hi(p->action) = b;
+  setDirty((addr - 2) >> 1);
+  return TRUE;
+}
+
+void doProgramCommand(t_programReport * pRequest)
+{
+  // Lets a host program read and write the actions directly, a block at a
+  // time, instead of the user entering them with the knob. Every command is
+  // answered with a program report holding the result.
+  t_programReport * pReply;
+  uint8_t * p;
+  uint8_t i;
+
+  p = newReport(1+sizeof(t_programReport));
+  p[0] = REPORT_ID_PROGRAM;
+  pReply = (t_programReport *)(p + 1);
+  pReply->command = pRequest->command;
+  pReply->offset = pRequest->offset;
+  pReply->status = PROGRAM_OK;
+  if (bProgramMode)                       // If the user is editing the actions with the knob
+  {
+    pReply->status = PROGRAM_BUSY;        // Don't change them behind the user's back
+  }
+  else if ((pRequest->command == PROGRAM_READ || pRequest->command == PROGRAM_WRITE) &&
+           pRequest->offset % PROGRAM_BLOCK_SIZE)
+  {
+    pReply->status = PROGRAM_INVALID;     // Aligned blocks always fit in the 256-byte image,
+                                          // but others would wrap round into its header
+  }
+  else
+  {
+    switch (pRequest->command)
+    {
+      case PROGRAM_READ:
+        for (i = 0; i < PROGRAM_BLOCK_SIZE; i++)
+        {
+          pReply->data[i] = getImageByte(pRequest->offset + i);
+        }
+        break;
+
+      case PROGRAM_WRITE:
+        for (i = 0; i < PROGRAM_BLOCK_SIZE; i++)
+        {
+          if (!setImageByte(pRequest->offset + i, pRequest->data[i]))
+            pReply->status = PROGRAM_INVALID;
+        }
+        if (nActionFocus > nAction)       // Check the focus against the count only once
+        {                                 // both are in, whichever was written
+          nActionFocus = nAction;
+          pReply->status = PROGRAM_INVALID;
+        }
+        break;
+
+      case PROGRAM_SAVE:
+      case PROGRAM_LOAD:
+        pReply->data[0] = PROGRAM_SLOTS;  // Tell the host how many programs there is room for
+        if (pRequest->offset >= PROGRAM_SLOTS)
+          pReply->status = PROGRAM_INVALID;
+        else if (pRequest->command == PROGRAM_SAVE)
+        {
+          if (!saveProgram(pRequest->offset))
+            pReply->status = PROGRAM_INVALID;
+        }
+        else
+          loadProgram(pRequest->offset);
+        break;
+
+      default:
+        pReply->status = PROGRAM_INVALID;
+        break;
+    }
+  }
+  queueReport();
+}
+
 
 
 
@@ -659,8 +1289,8 @@ void Prolog()
 
   NOT_RBPU_bit = 0;       // Enable PORTB weak pull-ups (PIC 18F25K50)
 
-  OSCCON = 0b01110000;
-//           x              0  = IDLEN: Sleep on SLEEP instruction
+  OSCCON = 0b11110000;
+//           x              1  = IDLEN: Idle (CPU stops, peripherals and USB run on) on SLEEP instruction
 //            xxx           111= IRCF: HFINTOSC (16 MHz)
 //               x          0  = OSTS: Status bit
 //                x         0  = HFIOFS: Status bit
@@ -712,21 +1342,34 @@ void Prolog()
 // Timer0 interrupt rate = 1.5 MHz / 65536 = 22.9 times per second (once every 43.7 ms)
 
 
-// Timer3 is used for human-scale delays (Timer3 is not always enabled)
-  T3CON   = 0b00110010;
+// Timer1 is not used, so it is left off
+  T1CON   = 0b00110010;
+//            xx             00 = TMR1CS: Timer1 clock source is instruction clock (Fosc/4)
+//              xx           11 = TMR1PS: Timer1 prescale value is 1:8
+//                x          0  = SOSCEN: Secondary Oscillator disabled
+//                 x         0  = T1SYNC: Ignored because TMR1CS = 0x
+//                  x        1  = RD16:   Enables register read/write of Timer1 in one 16-bit operation
+//                   x       0  = TMR1ON: Timer1 is off
+
+
+// Timer3 is the millisecond tick that waits and the long-press timer are timed by (Timer3 is always enabled)
+  TMR3H   = TIMER3_RELOAD >> 8;
+  TMR3L   = TIMER3_RELOAD & 0xFF;
+  T3CON   = 0b00110011;
 //            xx             00 = TMR3CS: Timer3 clock source is instruction clock (Fosc/4)
 //              xx           11 = TMR3PS: Timer3 prescale value is 1:8
 //                x          0  = SOSCEN: Secondary Oscillator disabled
 //                 x         0  = T3SYNC: Ignored because TMR3CS = 0x
 //                  x        1  = RD16:   Enables register read/write of Timer3 in one 16-bit operation
-//                   x       0  = TMR3ON: Timer3 is off
+//                   x       1  = TMR3ON: Timer3 is on
 // Timer3 tick rate = 48 MHz FOSC/4/8 = 1.5 MHz (667 ns)
-// Timer3 interrupt rate = 1.5 MHz / 65536 = 22.9 times per second
+// Timer3 interrupt rate = 1.5 MHz / 1500 = 1000 times per second (the interrupt reloads it)
 
   bUserInterrupt = FALSE;
   ACTIVITY_LED = OFF;
 
-  loadFromEEPROM();       // Load any existing script from the EEPROM at power up
+  storageInit();
+  loadProgram(0);         // Load any existing script from the storage at power up
 
   action.key.page = PAGE_KEYBOARD;
   action.key.usage = USB_KEY_A;
@@ -738,7 +1381,7 @@ void Prolog()
 //----------------------------------------------------------------------------
 
   TMR0IE_bit = 1;         // Enable Timer0 interrupts (to turn off LED)
-  TMR3IE_bit = 1;         // Enable Timer3 interrupts (for long press delay)
+  TMR3IE_bit = 1;         // Enable Timer3 interrupts (the millisecond tick)
   IOCIE_bit = 1;          // Enable PORTB/C Interrupt On Change interrupts
   PEIE_bit = 1;           // Enable peripheral interrupts
   GIE_bit = 1;            // Enable global interrupts
@@ -780,6 +1423,34 @@ const t_encoderState stateArray[] =
   AC2,  BEG, AC3, BEG|DIR_AC,  // AC3 Third transition anticlockwise
 };
 
+int8_t getSteps()
+{
+  // Takes the next entry from the step queue (0 if it is empty). The entry
+  // is claimed before it is read, so that from then on the interrupt routine
+  // starts a new entry instead of adding to this one
+  uint8_t n;
+  n = nStepHead;
+  if (n == nStepTail)
+    return 0;
+  nStepHead = (n + 1) & (STEP_QUEUE_SIZE - 1);
+  distance = aDistance[n];
+  return aSteps[n];
+}
+
+uint8_t isTurned()
+{
+  if (!rotation)
+    rotation = getSteps();
+  return rotation != 0;
+}
+
+void ignoreSteps()
+{
+  rotation = 0;
+  distance = 0;
+  nStepHead = nStepTail;
+}
+
 
 void selectAll()
 {
@@ -787,23 +1458,52 @@ void selectAll()
   sayKey(CTL|SHIFT, END);
 }
 
-void selectLine(uint8_t line)
+void moveToLine(uint8_t line)
 {
-  sayKey(CTL, HOME);
-  while (--line)
+  // Take the cheapest route to the line: from where the caret is now, or
+  // from the top or the bottom of the text. PageUp/PageDown are not used
+  // because how far they move depends on the size of the editor window.
+  uint8_t nLastLine;
+  uint8_t nFromHere;
+  uint8_t nFromTop;
+  uint8_t nFromEnd;
+
+  if (!bUSBReady) return;                               // The caret would never move
+  nLastLine = getLastLine();
+  if (line > nLastLine)                                 // DOWN stops at the last line and UP
+    line = nLastLine;                                   // at the first, so never aim past them
+  if (line < 1)
+    line = 1;
+  nFromTop = line;                                      // CTL+HOME then DOWN x (line-1)
+  nFromEnd = nLastLine-line+1;                          // CTL+END then UP x (nLastLine-line)
+  nFromHere = 255;
+  if (nCaretLine)
+    nFromHere = line > nCaretLine ? line-nCaretLine : nCaretLine-line;
+  if (nFromHere > nFromTop || nFromHere > nFromEnd)
+  {
+    sayKey(CTL, nFromTop <= nFromEnd ? HOME : END);
+  }
+  while (nCaretLine < line)
   {
     sayKey(NONE, DOWN);
   }
-  sayKey(SHIFT, END);
+  while (nCaretLine > line)
+  {
+    sayKey(NONE, UP);
+  }
 }
 
 void gotoLine(uint8_t line)
 {
-  sayKey(CTL, HOME);
-  while (--line)
-  {
-    sayKey(NONE, DOWN);
-  }
+  moveToLine(line);
+  if (nCaretColumn)                   // If not already at the start of the line (with
+    sayKey(NONE, HOME);               // nothing selected, see sayKey)
+}
+
+void selectLine(uint8_t line)
+{
+  gotoLine(line);
+  sayKey(SHIFT, END);
 }
 
 void deleteLastLine()
@@ -812,6 +1512,8 @@ void deleteLastLine()
   sayKey(SHIFT, HOME);
   sayKey(NONE, DELETE);
   sayKey(NONE, BACKSPACE);
+  nCaretLine = getLastLine() - 1;     // The caret is now at the end of the line above
+  nCaretColumn = COLUMN_UNKNOWN;
 }
 
 const char * getPageDesc (uint8_t page)
@@ -821,6 +1523,8 @@ const char * getPageDesc (uint8_t page)
     case PAGE_KEYBOARD:         return "Set Keystroke";
     case PAGE_SYSTEM_CONTROL:   return "Set System Control Command";
     case PAGE_CONSUMER_DEVICE:  return "Set Consumer Device Command";
+    case PAGE_REGISTER:         return "Execute Register Instruction";
+    case PAGE_CONTROL:          return "Control Program";
     case PAGE_DO:               return "Do Local Function";
     case PAGE_EXECUTE:          return "Execute Instruction";
     case PAGE_JUMP:             return "Jump On Condition";
@@ -835,7 +1539,7 @@ void sayPage()
   selectLine(SELECTION_LINE);
   // sayHex(nActionFocus);
   sayConst("   ");
-  toPrintableHex(action.key.page, &xWork);
+  toPrintableHex(action.key.page, xWork);
   say(&xWork[1]);
   sayConst("    ");
   sayConst(getPageDesc(action.key.page));
@@ -844,6 +1548,8 @@ void sayPage()
     case PAGE_KEYBOARD:
     case PAGE_SYSTEM_CONTROL:
     case PAGE_CONSUMER_DEVICE:
+    case PAGE_REGISTER:
+    case PAGE_CONTROL:
     case PAGE_DO:
     case PAGE_EXECUTE:
     case PAGE_JUMP:
@@ -857,6 +1563,42 @@ void sayPage()
   sayKey(SHIFT, HOME);   // Highlight this selection
 }
 
+void sayOperand(uint8_t operand, uint8_t value)
+{
+  switch (operand)
+  {
+    case OPERAND_FORMAT:
+      sayConst(FORMAT_DESC[value < ELEMENTS(FORMAT_DESC) ? value : FORMAT_HEX]);
+      break;
+    case OPERAND_MS:
+      sayDec(value);
+      sayConst(" ms");
+      break;
+    case OPERAND_SEC:
+      sayDec(value);
+      sayConst(" sec");
+      break;
+    case OPERAND_SIGNED:
+      sayConst(" by ");
+      saySignedDec(value);
+      break;
+    case OPERAND_ADDRESS:
+      sayConst(" to ");
+      sayHex(value);
+      break;
+    case OPERAND_NONE:
+      break;
+    case OPERAND_OFFSET:
+      sayHex(value);
+      sayChar(')');
+      break;
+    case OPERAND_HEX:
+    default:
+      sayHex(value);
+      break;
+  }
+}
+
 void sayUsage(uint8_t nAction, t_action * pAction)
 {
 
@@ -877,57 +1619,37 @@ void sayUsage(uint8_t nAction, t_action * pAction)
   {
     case PAGE_KEYBOARD:
       sayModifiers((t_keyboardAction *)pAction);
-      sayConst(getUsageDesc(pAction));
+      sayUsageText(getUsageText(pAction));
+      break;
+
+    case PAGE_SYSTEM_CONTROL:
+    case PAGE_CONSUMER_DEVICE:
+      sayUsageText(getUsageText(pAction));
       break;
 
     case PAGE_JUMP:
       sayConst(getUsageDesc(pAction));
-      if (pAction->key.mod == JUMP_RELATIVE)
-      {
-        sayConst(" by ");
-        saySignedDec(pAction->key.usage);
-      }
-      else
-      {
-        sayConst(" to ");
-        sayHex(pAction->key.usage);
-      }
+      sayOperand(JUMP_OPERAND[pAction->key.mod], pAction->key.usage);
       break;
 
     case PAGE_EXECUTE:
       sayConst(getUsageDesc(pAction));
-      switch (pAction->key.mod)
-      {
-        case EXECUTE_CLEAR:
-          sayHex(pAction->key.usage);
-          break;
-        case EXECUTE_WAIT_SEC:
-          sayDec(pAction->key.usage);
-          sayConst(" sec");
-          break;
-        case EXECUTE_WAIT_MS:
-          sayDec(pAction->key.usage);
-          sayConst(" ms");
-          break;
-        case EXECUTE_FORMAT:
-          switch (pAction->key.usage)
-          {
-            case FORMAT_CHAR:
-              sayConst("Char");
-              break;
-            case FORMAT_DEC:
-              sayConst("Decimal");
-              break;
-            case FORMAT_HEX:
-            default:
-              sayConst("Hex");
-              break;
-          }
-          break;
-        default:
-          sayHex(pAction->key.usage);
-          break;
-      }
+      sayOperand(EXECUTE_OPERAND[pAction->key.mod], pAction->key.usage);
+      break;
+
+    case PAGE_REGISTER:
+      sayConst(getUsageDesc(pAction));
+      sayOperand(REGISTER_OPERAND[pAction->key.mod], pAction->key.usage);
+      break;
+
+    case PAGE_CONTROL:
+      sayConst(getUsageDesc(pAction));
+      sayOperand(CONTROL_OPERAND[pAction->key.mod], pAction->key.usage);
+      break;
+
+    case PAGE_TEXT:
+      sayConst(getUsageDesc(pAction));
+      sayDec(pAction->key.usage);
       break;
 
     case PAGE_DO:
@@ -944,6 +1666,14 @@ void sayUsage(uint8_t nAction, t_action * pAction)
           sayHex(pAction->key.usage);
         }
       }
+      else if (pAction->key.mod == DO_LOAD || pAction->key.mod == DO_SAVE)
+      {
+        if (pAction->key.usage >= PROGRAM_SLOTS)
+        {
+          pAction->key.usage = PROGRAM_SLOTS-1;
+        }
+        sayHex(pAction->key.usage);
+      }
       break;
 
     default:
@@ -959,92 +1689,172 @@ void newLine()
 }
 
 
-void sayAction(uint8_t n)
+uint8_t getActionSize(uint8_t n)
 {
-  sayUsage(n, &aAction[n]);
+  // Number of actions taken by the action at n (a text run takes more than one)
+  if (aAction[n].key.page == PAGE_TEXT)
+    return 1 + TEXT_SLOTS(aAction[n].key.usage);
+  return 1;
 }
 
-void sayActions()
+uint8_t getActionStart(uint8_t n)
 {
+  // Finds the start of the action that n is part of (which is n itself
+  // unless n holds some characters of a text run)
   uint8_t i;
-
-  sayKey(CTL, END);
-  for (i = 0; i < nAction; i++)
+  uint8_t nSize;
+  for (i = 0; i < nAction; i += nSize)
   {
-    newLine();
-    sayAction(i);
+    nSize = getActionSize(i);
+    if (n < i + nSize)
+      return i;
   }
+  return n;
 }
 
-void nextKnownPage(int8_t rotation)
+void sayTextPart(uint8_t n)
 {
-  if (rotation)
-  {
-    do
-    {
-      action.key.page = 0x0F & (rotation > 0 ? action.key.page+1 : action.key.page-1);
-    }
-    while (!*getPageDesc(action.key.page));
-  }
+  // say "aa xxxx "cc"" for an action holding characters of a text run
+  uint8_t c;
+  sayHex(n);
+  sayKey(NONE, SPACE);
+  sayHex(Hi(aAction[n].action));
+  sayHex(Lo(aAction[n].action));
+  sayKey(NONE, SPACE);
+  sayChar('"');
+  c = Hi(aAction[n].action);
+  sayChar(c < ' ' || c > '~' ? '.' : c);  // Keep control characters off the display
+  c = Lo(aAction[n].action);
+  if (c)                                  // The last action of an odd length run is padded
+    sayChar(c < ' ' || c > '~' ? '.' : c);
+  sayChar('"');
 }
 
-uint16_t getNextConsumer (t_consumerDeviceAction * pAction)
+void sayAction(uint8_t n)
 {
-  uint16_t i;
-  for (i = pAction->usage+1; i < ELEMENTS(CONSUMER_DEVICE_DESC) && *CONSUMER_DEVICE_DESC[i] == '\0'; i++);
-  if (i >= ELEMENTS(CONSUMER_DEVICE_DESC))
-  {
-    for (i = 0; i < pAction->usage && *CONSUMER_DEVICE_DESC[i] == '\0'; i++);
-  }
-  return i;
+  if (getActionStart(n) != n)
+    sayTextPart(n);
+  else
+    sayUsage(n, &aAction[n]);
 }
 
-uint16_t getPrevConsumer (t_consumerDeviceAction * pAction)
+void showAction(uint8_t n)
 {
-  uint16_t i;
-  for (i = pAction->usage-1; i > 0 && i < ELEMENTS(CONSUMER_DEVICE_DESC) && *CONSUMER_DEVICE_DESC[i] == '\0'; i--);
-  if (i == 0 || i >= ELEMENTS(CONSUMER_DEVICE_DESC))
+  aShownIndex[n] = n;
+  aShownAction[n] = aAction[n];
+}
+
+void removeActionLine(uint8_t n)
+{
+  uint8_t i;
+
+  if (n >= nShownActions) return;
+  beginKeystrokes();
+  if (n == nShownActions-1) // If it is the line on the end
   {
-    for (i = ELEMENTS(CONSUMER_DEVICE_DESC)-1; i > pAction->usage && *CONSUMER_DEVICE_DESC[i] == '\0'; i--);
+    deleteLastLine();
+  }
+  else
+  {
+    gotoLine(START_ACTIONS_LINE+n);
+    sayKey(SHIFT, END);     // Select the line
+    sayKey(NONE, DELETE);   // Delete it
+    sayKey(NONE, DELETE);   // Delete the new line sequence so that the following lines move up
+    nCaretColumn = 0;
+  }
+  endKeystrokes();
+  nShownActions--;
+  for (i = n; i < nShownActions; i++)
+  {
+    aShownIndex[i] = aShownIndex[i+1];
+    aShownAction[i] = aShownAction[i+1];
   }
-  return i;
 }
 
-uint8_t getNextSys (t_systemControlAction * pAction)
+void renderActions()
 {
+  // Compare what is displayed with the actions, and only send the keystrokes
+  // needed to correct the lines that differ. A line that only shows the wrong
+  // action number (because a line above it was removed) just has the number
+  // overtyped.
   uint8_t i;
-  for (i = pAction->usage+1; i < ELEMENTS(SYSTEM_CONTROL_DESC) && *SYSTEM_CONTROL_DESC[i] == '\0'; i++);
-  if (i >= ELEMENTS(SYSTEM_CONTROL_DESC))
+
+  beginKeystrokes();
+  for (i = 0; i < nShownActions && i < nAction; i++)
+  {
+    if (aShownAction[i].action == aAction[i].action && aShownIndex[i] == i)
+      continue;  // This line is already correct
+    gotoLine(START_ACTIONS_LINE+i);
+    if (aShownAction[i].action == aAction[i].action)  // If only the action number is wrong
+    {
+      sayKey(SHIFT, RIGHT);
+      sayKey(SHIFT, RIGHT);   // Select the action number
+      sayHex(i);              // Overtype it
+    }
+    else
+    {
+      sayKey(SHIFT, END);     // Select the whole line
+      sayAction(i);           // Overtype it
+    }
+    showAction(i);
+  }
+  if (nShownActions < nAction)  // Append any new actions
+  {
+    sayKey(CTL, END);
+    for (i = nShownActions; i < nAction; i++)
+    {
+      newLine();
+      sayAction(i);
+      showAction(i);
+    }
+    nShownActions = nAction;
+  }
+  while (nShownActions > nAction) // Remove any surplus lines
   {
-    for (i = 0; i < pAction->usage && *SYSTEM_CONTROL_DESC[i] == '\0'; i++);
+    deleteLastLine();
+    nShownActions--;
   }
-  return i;
+  endKeystrokes();
 }
 
-uint8_t getPrevSys (t_systemControlAction * pAction)
+void nextKnownPage(int8_t rotation)
 {
-  uint8_t i;
-  for (i = pAction->usage-1; i > 0 && i < ELEMENTS(SYSTEM_CONTROL_DESC) && *SYSTEM_CONTROL_DESC[i] == '\0'; i--);
-  if (i == 0 || i >= ELEMENTS(SYSTEM_CONTROL_DESC))
+  for (; rotation; rotation > 0 ? rotation-- : rotation++)  // One known page per step
   {
-    for (i = ELEMENTS(SYSTEM_CONTROL_DESC)-1; i > pAction->usage && *SYSTEM_CONTROL_DESC[i] == '\0'; i--);
+    do
+    {
+      action.key.page = 0x0F & (rotation > 0 ? action.key.page+1 : action.key.page-1);
+    }
+    while (!*getPageDesc(action.key.page));
   }
-  return i;
 }
 
 
-void nextKnownUsage(int8_t rotation)
+void nextKnownUsage(int8_t rotation, int16_t distance)
 {
+  // Slow turns step through the known usages one at a time. Fast ones
+  // jump most of the weighted distance, and then step to the next known
+  // usage. The 8-bit tables are a sixteenth the size of the consumer device
+  // table, so they jump an eighth as far
+  int16_t jump;
+  jump = 0;
+  if (distance != rotation)         // If any step was fast
+  {
+    jump = distance > 0 ? distance - 1 : distance + 1;
+    rotation = distance > 0 ? 1 : -1;
+  }
   switch (action.key.page)
   {
     case PAGE_CONSUMER_DEVICE:
-      action.cons.usage = rotation > 0 ? getNextConsumer(&action.cons) : getPrevConsumer(&action.cons);
+      action.cons.usage += jump;
+      action.cons.usage = stepUsage(CONSUMER_DEVICE_USAGE, ELEMENTS(CONSUMER_DEVICE_USAGE), action.cons.usage, rotation);
       break;
     case PAGE_SYSTEM_CONTROL:
-      action.sys.usage = rotation > 0 ? getNextSys(&action.sys) : getPrevSys(&action.sys);
+      action.sys.usage += jump / 8;
+      action.sys.usage = stepUsage(SYSTEM_CONTROL_USAGE, ELEMENTS(SYSTEM_CONTROL_USAGE), action.sys.usage, rotation);
       break;
     default:
-      rotation > 0 ? action.key.usage++ : action.key.usage--; // 8-bit keyboard usage
+      action.key.usage += jump / 8 + rotation; // 8-bit keyboard usage
       break;
   }
 }
@@ -1053,6 +1863,9 @@ void clearDisplay()
 {
   selectAll();
   sayKey(NONE, DELETE);
+  nShownActions = 0;
+  nCaretLine = 1;
+  nCaretColumn = 0;
 }
 
 void setFocus(uint8_t newFocus)
@@ -1076,6 +1889,12 @@ void setFocus(uint8_t newFocus)
       case PAGE_CONSUMER_DEVICE:
         sayConst("Cons:   Turn=Select"); // , Press=OK, Press+Hold=Return
         break;
+      case PAGE_REGISTER:
+        sayConst("Reg:    Turn=Modify, Press+Turn=Select"); // , Press=OK, Press+Hold=Return
+        break;
+      case PAGE_CONTROL:
+        sayConst("Ctrl:   Turn=Modify, Press+Turn=Select"); // , Press=OK, Press+Hold=Return
+        break;
       case PAGE_DO:
         sayConst("Do:     Turn=Modify, Press+Turn=Select"); // , Press=OK, Press+Hold=Return
         break;
@@ -1093,37 +1912,40 @@ void setFocus(uint8_t newFocus)
   selectLine(SELECTION_LINE);
 }
 
+void removeActions(uint8_t n, uint8_t nCount)
+{
+  uint8_t i;
+  if (n + nCount > nAction)         // If a text run is cut short
+    nCount = nAction - n;
+  for (i = n; i + nCount < nAction; i++)
+  {
+    aAction[i] = aAction[i+nCount];
+    setDirty(i);           // Moved up
+  }
+  for (; i < nAction; i++)
+  {
+    aAction[i].action = 0; // Clear the vacated actions
+  }
+  nAction -= nCount;
+}
+
 void deleteAction(uint8_t n)
 {
   // TODO: Ideally this should also adjust any GOTO actions etc
   uint8_t i;
+  uint8_t nCount;
 
   if (nAction) // If anything to delete
   {
-    if (n == (nAction-1)) // If it is the action on the end
-    {
-      nAction--; // Delete the last action (effectively)
-      nActionFocus = nAction;
-      deleteLastLine(); // Delete last action from the display
-    }
-    else  // Delete an action which is not at the end
+    n = getActionStart(n);            // Delete the whole of a text run
+    nCount = getActionSize(n);
+    removeActions(n, nCount);
+    nActionFocus = nAction;
+    for (i = 0; i < nCount; i++)
     {
-      for (i = n; i < nAction; i++)
-      {
-        aAction[i] = aAction[i+1];
-      }
-      nAction--; // We now have one less action in the array
-      nActionFocus = nAction;
-      gotoLine(START_ACTIONS_LINE+n);
-      sayKey(CTL|SHIFT, END); // Select all actions from there onwards
-      sayKey(NONE, DELETE);   // Delete them
-      sayKey(SHIFT, LEFT);    // Select previous line's new line sequence
-      for (i = n; i < nAction; i++)
-      {
-        newLine();
-        sayAction(i);
-      }
+      removeActionLine(n);  // Delete the action from the display...
     }
+    renderActions();      // ...and renumber the actions that moved up
     selectLine(SELECTION_LINE);
   }
 }
@@ -1154,26 +1976,27 @@ void changePage()
 {
   while (ROTARY_BUTTON_PRESSED)
   {
-    if (rotation) // If the rotary knob is being turned while pressed
+    if (isTurned()) // If the rotary knob is being turned while pressed
     {
-      TMR3ON_bit = 0;   // Disable long-press timer
-      if (rotation > 0) // Clockwise rotation
+      stopTimer();  // Stop long-press timer
+      for (; rotation > 0; rotation--)  // Clockwise rotation
       {
         if (nActionFocus < nAction)
           nActionFocus++;
       }
-      else              // Anticlockwise rotation
+      for (; rotation < 0; rotation++)  // Anticlockwise rotation
       {
         if (nActionFocus > 0)
           nActionFocus--;
         else if (nActionFocus == 0 && nAction)
           nActionFocus = nAction;
       }
-      sayPage();
+      sayPage();                        // Once for all the steps
       rotation = 0;  // Indicate rotary event handled
     }
     else // The rotary knob is being pressed but not turned
     {
+      sendReports();  // Keep the display up to date
     }
   }
   selectFirstUsage();
@@ -1188,9 +2011,19 @@ void displayProgrammingMenu()
   newLine();
   newLine();
   newLine();
+  if (bCallStackOverflow)           // If the last play stopped on a Call too deep
+  {
+    sayConst("Call stack overflow at ");
+    sayHex(nStoppedAt);
+  }
+  else if (bChainRefused)           // If it stopped rather than lose unsaved edits
+  {
+    sayConst("Save before chaining at ");
+    sayHex(nStoppedAt);
+  }
   newLine();
   sayConst("At Code Action");
-  sayActions();
+  renderActions();
   action.key.page = PAGE_KEYBOARD;
   action.key.usage = USB_KEY_A;
   action.key.mod = 0;
@@ -1198,35 +2031,64 @@ void displayProgrammingMenu()
   setFocus(FOCUS_ON_PAGE);
 }
 
+void storeAction()
+{
+  if (nActionFocus >= nAction) // If we are appending a new action
+  {
+    if (nActionFocus < ELEMENTS(aAction))  // If room to add an action
+    {
+      aAction[nActionFocus] = action;
+      setDirty(nActionFocus);
+      nAction++;        // Set new high water mark
+      renderActions();  // Display the new action
+    }
+  }
+  else  // We are updating an existing action
+  {
+    nActionFocus = getActionStart(nActionFocus);  // Replace the whole of a text run
+    removeActions(nActionFocus + 1, getActionSize(nActionFocus) - 1);
+    aAction[nActionFocus] = action;
+    setDirty(nActionFocus);
+    renderActions();    // Display the updated action
+  }
+  nActionFocus++;   // Automatically focus on the following action
+}
+
 void changeUsage()
 {
   uint8_t bAppendAction;
 
   bAppendAction = TRUE;
-  nRemainingTimerTicks = INTERVAL_IN_SECONDS(1);
-  TMR3ON_bit = 1;   // Enable long-press timer
+  startTimer(INTERVAL_IN_SECONDS(1));  // Start long-press timer
   while (ROTARY_BUTTON_PRESSED)
   {
-    if (rotation) // If the rotary knob is being turned while pressed
+    if (isTurned()) // If the rotary knob is being turned while pressed
     {
-      TMR3ON_bit = 0;   // Disable long-press timer
+      stopTimer();  // Stop long-press timer
       bAppendAction = FALSE;
       selectLine(SELECTION_LINE);
       switch (action.key.page)
       {
-        case PAGE_KEYBOARD:         // Push+turn adjusts the key modifier (ALT, SHIFT etc)
         case PAGE_DO:               // Push+turn adjusts the local function
+          action.key.mod += rotation;
+          if (action.key.mod == DO_LOAD || action.key.mod == DO_SAVE)
+            action.key.usage = nProgram;  // Start at the program being edited
+          break;
+
+        case PAGE_KEYBOARD:         // Push+turn adjusts the key modifier (ALT, SHIFT etc)
+        case PAGE_REGISTER:         // Push+turn adjusts the register instruction
+        case PAGE_CONTROL:          // Push+turn adjusts the control function
         case PAGE_EXECUTE:          // Push+turn adjusts the instruction
         case PAGE_JUMP:             // Push+turn adjusts the jump condition
-          rotation > 0 ? action.key.mod++ : action.key.mod--;
+          action.key.mod += rotation;
           break;
 
         case PAGE_CONSUMER_DEVICE:  // Push+turn adjusts the 12-bit usage directly
-          rotation > 0 ? action.cons.usage++ : action.cons.usage--;
+          action.cons.usage += rotation;
           break;
 
         default:                    // Push+turn adjusts the 8-bit usage directly
-          rotation > 0 ? action.key.usage++  : action.key.usage--;
+          action.key.usage += rotation;
           break;
       }
       sayUsage(nActionFocus, &action);
@@ -1234,14 +2096,17 @@ void changeUsage()
     }
     else // The rotary knob is being pressed but not turned
     {
+      sendReports();  // Keep the display up to date
     }
   }
   // Rotary button released...
-  TMR3ON_bit = 0;   // Disable long-press timer
+  stopTimer();  // Stop long-press timer
   if (bAppendAction)
   {
     if (action.key.page == PAGE_DO) // If we are doing a local function
     {
+      if (action.key.mod != DO_STATISTICS)
+        beginMeasurement();
       switch (action.key.mod)
       {
         case DO_DELETE:                     // Delete action
@@ -1249,17 +2114,27 @@ void changeUsage()
           break;
 
         case DO_SAVE:
-          saveInEEPROM();
           clearDisplay();
-          sayConst("Saved in EEPROM");      // Save actions in EEPROM
+          if (saveProgram(action.key.usage)) // Save actions in storage
+          {
+            sayConst("Saved as program ");
+            sayHex(nProgram);
+          }
+          else
+          {
+            sayConst("Not saved: a program can keep ");
+            sayDec(MAX_SAVED_ACTIONS);
+            sayConst(" actions here");
+          }
           sayKey(SHIFT, HOME);              // Highlight it
           bProgramMode = FALSE;
           break;
 
         case DO_LOAD:
-          loadFromEEPROM();
+          loadProgram(action.key.usage);    // Re-instate actions from storage
           clearDisplay();
-          sayConst("Reloaded from EEPROM"); // Re-instate actions from EEPROM
+          sayConst("Loaded program ");
+          sayHex(nProgram);
           sayKey(SHIFT, HOME);              // Highlight it
           bProgramMode = FALSE;
           break;
@@ -1267,29 +2142,28 @@ void changeUsage()
         case DO_REDISPLAY:
           displayProgrammingMenu();
           break;
+
+        case DO_CALIBRATE:
+          calibrateReportRate();
+          selectLine(INFO_LINE);
+          sayConst("Host: ");
+          sayReportRate();                  // Show the measured rate
+          selectLine(SELECTION_LINE);
+          break;
+
+        case DO_STATISTICS:
+          selectLine(INFO_LINE);
+          sayConst("Last: ");
+          sayStatistics();                  // Show the cost of the last operation
+          selectLine(SELECTION_LINE);
+          break;
       }
+      if (action.key.mod != DO_STATISTICS)
+        endMeasurement();
     }
     else  // we are appending or updating an action
     {
-      if (nActionFocus >= nAction) // If we are appending a new action
-      {
-        if (nActionFocus < ELEMENTS(aAction))  // If room to add an action
-        {
-          sayKey(CTL, END);
-          newLine();
-
-          aAction[nActionFocus] = action;
-          sayAction(nActionFocus);
-          nAction++;        // Set new high water mark
-        }
-      }
-      else  // We are updating an existing action
-      {
-        aAction[nActionFocus] = action;
-        selectLine(START_ACTIONS_LINE+nActionFocus);
-        sayAction(nActionFocus);
-      }
-      nActionFocus++;   // Automatically focus on the following action
+      storeAction();
       selectLine(SELECTION_LINE);
       sayUsage(nActionFocus, &action);
       selectLine(SELECTION_LINE);
@@ -1299,7 +2173,7 @@ void changeUsage()
 
 void programMode()
 {
-  if (rotation)
+  if (isTurned())
   {
     switch (focus)
     {
@@ -1309,7 +2183,7 @@ void programMode()
         break;
 
       case FOCUS_ON_USAGE:  // User is adjusting the usage within a page
-        nextKnownUsage(rotation);
+        nextKnownUsage(rotation, distance);
         selectLine(SELECTION_LINE);
         sayUsage(nActionFocus, &action);
         sayKey(SHIFT, HOME);    // Highlight action
@@ -1323,28 +2197,28 @@ void programMode()
   else if (ROTARY_BUTTON_PRESSED)
   {
     bUserInterrupt = FALSE;
-    Delay_ms(5);  // Cheap debounce
+    pause(5);  // Cheap debounce
     if (ROTARY_BUTTON_PRESSED) // If still pressed
     {
-      nRemainingTimerTicks = INTERVAL_IN_SECONDS(1);  // Long press timer
       bLongPress = FALSE;
-      TMR3ON_bit = 1;   // Enable long-press timer
-      while (ROTARY_BUTTON_PRESSED && !rotation && !bLongPress) // pressed but not rotated
+      startTimer(INTERVAL_IN_SECONDS(1));  // Start long-press timer
+      while (ROTARY_BUTTON_PRESSED && !isTurned() && !bLongPress) // pressed but not rotated
       {
-        if (TMR3ON_bit && nRemainingTimerTicks == 0) // If it is a long press
+        sendReports();
+        if (isTimerExpired()) // If it is a long press
         {
-          TMR3ON_bit = 0; // Stop the long press timer
+          stopTimer();  // Stop long-press timer
           bLongPress = TRUE;
         }
       }
-      TMR3ON_bit = 0; // Stop the long press timer
+      stopTimer();  // Stop long-press timer
       switch (focus)
       {
         case FOCUS_ON_PAGE:
           if (bLongPress)
           {
             clearDisplay();
-            sayConst("Not saved in EEPROM");    // Leave actions in EEPROM unchanged
+            sayConst("Not saved");              // Leave actions in storage unchanged
             sayKey(SHIFT, HOME);                // Highlight it
             bProgramMode = FALSE;
           }
@@ -1369,10 +2243,13 @@ void programMode()
         default:
           break;
       }
-      while (ROTARY_BUTTON_PRESSED);  // Wait until button is released
-      Delay_ms(5);  // Cheap debounce
+      while (ROTARY_BUTTON_PRESSED)   // Wait until button is released
+      {
+        sendReports();
+      }
+      pause(5);  // Cheap debounce
     }
-    rotation = 0;  // Ignore rotary while button pressed
+    ignoreSteps();  // Ignore rotary while button pressed
   }
   else // rotary button is not currently being pressed or rotated
   {
@@ -1389,20 +2266,38 @@ void setMemory(uint8_t addr, uint8_t value)
   MEMORY[addr] = value;
 }
 
-void setConditionCode(int8_t n)
+uint8_t setConditionCode(uint16_t result)
 {
-  if (n == 0)
+  // Sets Z, M or P from the 8-bit result, as before, and also sets O if the
+  // arithmetic (done 16 bits wide) carried out of, or borrowed into, it.
+  // Returns the 8-bit result
+  if (Lo(result) == 0)
     CC = CC_Z;
-  else if (n > 0)
-    CC = CC_P;
+  else if (Lo(result) & 0x80)
+    CC = CC_M;
   else
+    CC = CC_P;
+  if (Hi(result))
+    CC |= CC_O;
+  return Lo(result);
+}
+
+void setCompareCode(uint8_t a, uint8_t b)
+{
+  // Compares a to b as unsigned numbers: Equal, Low or High
+  if (a == b)
+    CC = CC_Z;
+  else if (a < b)
     CC = CC_M;
+  else
+    CC = CC_P;
 }
 
 void playInstruction(t_action * pAction)
 {
   uint8_t i;
-  uint16_t nIntervals;
+  uint16_t deadline;
+  uint16_t fraction;
   switch (pAction->inst.opcode)
   {
     case EXECUTE_SET:                 // W = xx    (load constant xx)
@@ -1418,11 +2313,11 @@ void playInstruction(t_action * pAction)
       break;
 
     case EXECUTE_COMPARE_IMMEDIATE:   // W : xx
-      setConditionCode(WRK - pAction->inst.operand);
+      setCompareCode(WRK, pAction->inst.operand);
       break;
 
     case EXECUTE_COMPARE:             // W : [xx]
-      setConditionCode(WRK - getMemory(pAction->inst.operand));
+      setCompareCode(WRK, getMemory(pAction->inst.operand));
       break;
 
     case EXECUTE_SAY:                 // SAY f(xx,format)
@@ -1446,58 +2341,169 @@ void playInstruction(t_action * pAction)
       break;
 
     case EXECUTE_ADD_IMMEDIATE:       // W = W + xx
-      WRK = WRK + pAction->inst.operand;
-      setConditionCode(WRK);
+      WRK = setConditionCode((uint16_t)WRK + pAction->inst.operand);
       break;
 
     case EXECUTE_SUB_IMMEDIATE:       // W = W - xx
-      WRK = WRK - pAction->inst.operand;
-      setConditionCode(WRK);
+      WRK = setConditionCode((uint16_t)WRK - pAction->inst.operand);
       break;
 
     case EXECUTE_CLEAR:               // xx -> [00-FF]
-      for (i = 0; i < sizeof(MEMORY); i++)
+      for (i = 0; i < sizeof(MEMORY) - 1; i++) // i cannot count to 256
       {
         setMemory(i, pAction->inst.operand);
       }
-      setMemory(sizeof(MEMORY), pAction->inst.operand);
+      setMemory(sizeof(MEMORY) - 1, pAction->inst.operand);
       break;
 
     case EXECUTE_ADD:                 // W = W + [xx]
-      WRK = WRK + getMemory(pAction->inst.operand);
-      setConditionCode(WRK);
+      WRK = setConditionCode((uint16_t)WRK + getMemory(pAction->inst.operand));
       break;
 
     case EXECUTE_SUB:                 // W = W - [xx]
-      WRK = WRK - getMemory(pAction->inst.operand);
-      setConditionCode(WRK);
+      WRK = setConditionCode((uint16_t)WRK - getMemory(pAction->inst.operand));
       break;
 
-    case EXECUTE_MUL:                 // W = W x [xx]
-      WRK = WRK * getMemory(pAction->inst.operand);
-      setConditionCode(WRK);
+    case EXECUTE_MUL:                 // W = W x [xx]  (O if the product is over FF)
+      WRK = setConditionCode((uint16_t)WRK * getMemory(pAction->inst.operand));
       break;
 
-    case EXECUTE_DIV:                 // W = W / [xx]
-      WRK = WRK / getMemory(pAction->inst.operand);
-      setConditionCode(WRK);
+    case EXECUTE_DIV:                 // W = W / [xx]  (O, and W unchanged, if [xx] is 0)
+      i = getMemory(pAction->inst.operand);
+      if (i)
+        WRK = setConditionCode(WRK / i);
+      else
+        CC = CC_O;
       break;
 
-    case EXECUTE_WAIT_SEC:            // Wait 0 to 255 seconds (approximately)
+    case EXECUTE_WAIT_SEC:            // Wait 0 to 255 seconds
       sayNoKeyPressed();  // Release key (otherwise host will do a "key repeat")
-      nIntervals = 200 * pAction->inst.operand;  // Number of 5 ms intervals to wait
-      while (nIntervals-- && !bUserInterrupt)    // Long waits can be interrupted
+      waitForReports();   // Start timing when the host has seen the keys
+      deadline = getTicks();
+      for (i = pAction->inst.operand; i && !bUserInterrupt; i--)  // Long waits can be interrupted
       {
-        Delay_ms(5);
+        deadline += INTERVAL_IN_SECONDS(1);  // A second at a time, so that no deadline is too far off
+        parkUntil(deadline, TRUE);
       }
       break;
 
-    case EXECUTE_WAIT_MS:             // Wait 0 to 255 milliseconds (approximately)
-      nIntervals = pAction->inst.operand; // Number of 1 ms intervals to wait
-      while (nIntervals--)
+    case EXECUTE_WAIT_MS:             // Wait 0 to 255 milliseconds
+      flushKeystrokes();  // Send any keys typed so far before waiting
+      waitForReports();   // Start timing when the host has seen the keys
+      TMR3IE_bit = 0;
+      deadline = nTickCount + pAction->inst.operand;
+      fraction = getTimer3();         // How far into the current millisecond the wait starts
+      TMR3IE_bit = 1;
+      parkUntil(deadline, TRUE);
+      while (getTicks() == deadline && getTimer3() < fraction && !bUserInterrupt)
+        ;                             // Wait out the part of a millisecond too
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+void sayPair(uint8_t addr)
+{
+  uint16_t value;
+  char * p;
+  char sString[6]; // "nnnnn"
+  Lo(value) = getMemory(addr);
+  Hi(value) = getMemory(addr + 1);
+  switch (FORMAT)
+  {
+    case FORMAT_DEC:
+      WordToStr(value, sString);
+      for (p=sString; *p == ' '; p++);  // Find first non-blank
+      say(p);                            // For example: 1000
+      break;
+    case FORMAT_CHAR:                    // Characters come in ones
+    case FORMAT_HEX:
+    default:
+      sayHex(Hi(value));                 // For example: 03E8
+      sayHex(Lo(value));
+      break;
+  }
+}
+
+void setPairConditionCode(uint16_t n, uint8_t bCarry)
+{
+  if (n == 0)
+    CC = CC_Z;
+  else if (Hi(n) & 0x80)
+    CC = CC_M;
+  else
+    CC = CC_P;
+  if (bCarry)
+    CC |= CC_O;
+}
+
+void playRegisterInstruction(t_action * pAction)
+{
+  uint16_t pair;
+  uint8_t addr;
+  addr = pAction->inst.operand;
+  switch (pAction->inst.opcode)
+  {
+    case REGISTER_SET_INDEX:          // X = xx
+      IDX = addr;
+      break;
+
+    case REGISTER_GET_INDEXED:        // W <- [X+xx]
+      WRK = getMemory(IDX + addr);
+      break;
+
+    case REGISTER_PUT_INDEXED:        // W -> [X+xx]
+      setMemory(IDX + addr, WRK);
+      break;
+
+    case REGISTER_ADD_INDEX:          // X = X + xx
+      IDX = setConditionCode((uint16_t)IDX + addr);
+      break;
+
+    case REGISTER_GET_INDEX:          // X <- [xx]
+      IDX = getMemory(addr);
+      break;
+
+    case REGISTER_PUT_INDEX:          // X -> [xx]
+      setMemory(addr, IDX);
+      break;
+
+    case REGISTER_LOOP_W:             // W = W - 1 (the jump is done by runLoop)
+      WRK = setConditionCode((uint16_t)WRK - 1);
+      break;
+
+    case REGISTER_LOOP_X:             // X = X - 1 (the jump is done by runLoop)
+      IDX = setConditionCode((uint16_t)IDX - 1);
+      break;
+
+    case REGISTER_PUT_PAIR:           // W -> [xx+1,xx]
+      setMemory(addr, WRK);
+      setMemory(addr + 1, 0);
+      break;
+
+    case REGISTER_ADD_PAIR:           // [xx+1,xx] = [xx+1,xx] + W
+    case REGISTER_SUB_PAIR:           // [xx+1,xx] = [xx+1,xx] - W
+      Lo(pair) = getMemory(addr);
+      Hi(pair) = getMemory(addr + 1);
+      if (pAction->inst.opcode == REGISTER_ADD_PAIR)
       {
-        Delay_ms(1);
+        pair = pair + WRK;
+        setPairConditionCode(pair, pair < WRK);   // Carry if it wrapped past FFFF
       }
+      else
+      {
+        setPairConditionCode(pair - WRK, pair < WRK); // Borrow if W was the bigger
+        pair = pair - WRK;
+      }
+      setMemory(addr, Lo(pair));
+      setMemory(addr + 1, Hi(pair));
+      break;
+
+    case REGISTER_SAY_PAIR:           // SAY f([xx+1,xx],format)
+      sayPair(addr);
       break;
 
     default:
@@ -1505,90 +2511,285 @@ void playInstruction(t_action * pAction)
   }
 }
 
-
-void play()
+void decodeProgram()
 {
-  uint8_t pc;             // Program Counter (instruction address)
-  t_action * pAction = &aAction;
-  bUserInterrupt = FALSE; // The user can interrupt playback by pressing the button
-  for (pc = 0; pc < nAction && !bUserInterrupt; pc++, pAction++)
+  // Works out what play() must do for each action, before it starts, so
+  // that the actions are not decoded again each time round a loop. Jumps to
+  // places outside the program, or into a text run, are ignored (as are
+  // chains to programs that there is no room for).
+  t_action * pAction;
+  uint8_t pc;
+  uint8_t nSize;
+  uint8_t target;
+
+  pAction = aAction;
+  for (pc = 0; pc < nAction; pc++, pAction++)
   {
-    ACTIVITY_LED = ON;         // The LED will be turned off by the next timer interrupt
     switch (pAction->key.page)
     {
-      case PAGE_KEYBOARD:
-        playKeystroke(pAction);
-        break;
-
-      case PAGE_SYSTEM_CONTROL:
-        playSystemControlCommand(pAction);
+      case PAGE_KEYBOARD:         aOp[pc] = OP_KEYSTROKE;       break;
+      case PAGE_SYSTEM_CONTROL:   aOp[pc] = OP_SYSTEM_CONTROL;  break;
+      case PAGE_CONSUMER_DEVICE:  aOp[pc] = OP_CONSUMER;        break;
+      case PAGE_EXECUTE:          aOp[pc] = OP_INSTRUCTION;     break;
+
+      case PAGE_REGISTER:
+        aOp[pc] = OP_REGISTER;
+        if (pAction->inst.opcode == REGISTER_LOOP_W || pAction->inst.opcode == REGISTER_LOOP_X)
+          aOp[pc] = OP_LOOP;
         break;
 
-      case PAGE_CONSUMER_DEVICE:
-        playConsumerDeviceCommand(pAction);
+      case PAGE_TEXT:
+        aOp[pc] = OP_TEXT;
+        for (nSize = getActionSize(pc); --nSize && pc+1 < nAction; )
+        {
+          aOp[++pc] = OP_DATA;      // The characters are typed by OP_TEXT
+          pAction++;
+        }
         break;
 
-      case PAGE_EXECUTE:
-        playInstruction(pAction);
+      case PAGE_CONTROL:
+        aOp[pc] = OP_NOP;
+        switch (pAction->key.mod)
+        {
+          case CONTROL_CHAIN:
+            if (pAction->key.usage < PROGRAM_SLOTS)
+              aOp[pc] = OP_CHAIN;
+            break;
+          case CONTROL_CALL:
+            aOp[pc] = OP_CALL;
+            break;
+          case CONTROL_RETURN:
+            aOp[pc] = OP_RETURN;
+            break;
+          default:
+            break;
+        }
         break;
 
-      case PAGE_JUMP:
+      case PAGE_JUMP:             // Condition Code: ZLHC (Side note: This is similar to IBM mainframes)
         switch (pAction->jump.mask)
-        { //                       Condition Code: ZLHC (Side note: This is similar to IBM mainframes)
-          case JUMP_RELATIVE:                   // 0000 (...not this though. IBM mainframes use mask 0 as a No-op)
-            if ((uint8_t)(pc + (int8_t) pAction->jump.addr) < nAction)
-            {
-              pc += (int8_t) pAction->jump.addr;
-              pAction = &aAction[pc];
-              pAction--;
-              pc--;
-            }
+        {
+          case JUMP_RELATIVE:     // 0000 (...not this though. IBM mainframes use mask 0 as a No-op)
+            aOp[pc] = OP_JUMP_RELATIVE;
             break;
-                                                // ELH- <- Comparison
-                                                // ZMPO <- Arithmetic
-          case JUMP_IF_CARRY:                   // 0001
-          case JUMP_IF_HIGH:                    // 0010
-          case JUMP_IF_HIGH_OR_CARRY:           // 0011
-          case JUMP_IF_LOW:                     // 0100
-          case JUMP_IF_LOW_OR_CARRY:            // 0101
-          case JUMP_IF_NOT_ZERO_OR_CARRY:       // 0110
-          case JUMP_IF_NOT_ZERO:                // 0111
-          case JUMP_IF_ZERO:                    // 1000
-          case JUMP_IF_ZERO_OR_CARRY:           // 1001
-          case JUMP_IF_NOT_LOW_OR_CARRY:        // 1010
-          case JUMP_IF_NOT_LOW:                 // 1011
-          case JUMP_IF_ZERO_OR_LOW:             // 1100
-          case JUMP_IF_NOT_HIGH:                // 1101
-          case JUMP_IF_NOT_CARRY:               // 1110
-            if (!(pAction->jump.mask & CC))     // If none of the required mask bits are on in the current Condition Code
-              break;                            // Then the condition is not met, so ignore the jump instruction
-            // Else fall through to...
-          case JUMP:                            // 1111
-            if (pAction->jump.addr < nAction)
-            {
-              pc = pAction->jump.addr;          // Set the new Program Counter location
-              pAction = &aAction[pc];           // Point to the action at that location
-              pAction--;                        // Adjust down by 1 because the outer loop
-              pc--;                             // will increment it
-            }
-            // Else ignore jumps to destinations outside the current program size
+          case JUMP:              // 1111
+            aOp[pc] = OP_JUMP;
             break;
-
-          default:
+          case JUMP_IF_NOT_ZERO_OR_CARRY: // 0110
+          case JUMP_IF_NOT_ZERO:          // 0111
+          case JUMP_IF_NOT_LOW_OR_CARRY:  // 1010
+          case JUMP_IF_NOT_LOW:           // 1011
+          case JUMP_IF_NOT_HIGH:          // 1101
+          case JUMP_IF_NOT_CARRY:         // 1110
+            aOp[pc] = OP_JUMP_IF_NOT;     // O can be on alongside Z, M or P, so these
+            break;                        // must test that the opposite condition is not met
+          default:                // Jump if any of the mask bits are on in the Condition Code
+            aOp[pc] = OP_JUMP_IF;
             break;
         }
         break;
 
       default:
+        aOp[pc] = OP_NOP;
+        break;
+    }
+  }
+
+  pAction = aAction;               // Now that every action start is known...
+  for (pc = 0; pc < nAction; pc++, pAction++)
+  {
+    switch (aOp[pc])
+    {
+      case OP_JUMP_RELATIVE:
+        target = pc + (int8_t)pAction->jump.addr;
+        break;
+      case OP_JUMP:
+      case OP_JUMP_IF:
+      case OP_JUMP_IF_NOT:
+      case OP_CALL:
+      case OP_LOOP:
+        target = pAction->jump.addr;
         break;
+      default:
+        continue;
     }
+    if (target >= nAction || aOp[target] == OP_DATA)
+      aOp[pc] = aOp[pc] == OP_LOOP ? OP_REGISTER : OP_NOP;  // ...ignore jumps to nowhere
+  }
+}
+
+uint8_t runNothing(uint8_t pc)
+{
+  return pc + 1;
+}
+
+uint8_t runKeystroke(uint8_t pc)
+{
+  playKeystroke(&aAction[pc]);
+  return pc + 1;
+}
+
+uint8_t runSystemControl(uint8_t pc)
+{
+  playSystemControlCommand(&aAction[pc]);
+  return pc + 1;
+}
+
+uint8_t runConsumer(uint8_t pc)
+{
+  playConsumerDeviceCommand(&aAction[pc]);
+  return pc + 1;
+}
+
+uint8_t runText(uint8_t pc)
+{
+  return pc + 1 + playText(pc);       // Skip the characters
+}
+
+uint8_t runInstruction(uint8_t pc)
+{
+  playInstruction(&aAction[pc]);
+  return pc + 1;
+}
+
+uint8_t runRegister(uint8_t pc)
+{
+  playRegisterInstruction(&aAction[pc]);
+  return pc + 1;
+}
+
+uint8_t runLoop(uint8_t pc)
+{
+  playRegisterInstruction(&aAction[pc]);  // Count down...
+  if (CC & CC_Z)
+    return pc + 1;                        // ...until zero
+  return aAction[pc].jump.addr;
+}
+
+uint8_t runJumpIf(uint8_t pc)
+{
+  if (aAction[pc].jump.mask & CC)     // If any of the required mask bits are on in the current Condition Code
+    return aAction[pc].jump.addr;
+  return pc + 1;                      // Else the condition is not met, so ignore the jump instruction
+}
+
+uint8_t runJumpIfNot(uint8_t pc)
+{
+  if (~aAction[pc].jump.mask & CC)    // If any of the bits for the opposite condition are on
+    return pc + 1;                    // then this condition is not met, so ignore the jump instruction
+  return aAction[pc].jump.addr;
+}
+
+uint8_t runJump(uint8_t pc)
+{
+  return aAction[pc].jump.addr;
+}
+
+uint8_t runJumpRelative(uint8_t pc)
+{
+  return pc + (int8_t)aAction[pc].jump.addr;
+}
+
+uint8_t runChain(uint8_t pc)
+{
+  if (isAnyBitSet(aDirty))            // Loading another program would lose the edits
+  {                                   // not yet saved (nor could this one be put back
+    bChainRefused = TRUE;             // afterwards), so stop playing here instead
+    return pc;
+  }
+  loadProgram(aAction[pc].key.usage); // Replace the program being played...
+  decodeProgram();
+  nCallDepth = 0;                     // ...forget where it was called from...
+  return 0;                           // ...and play it from the start
+}
+
+uint8_t runCall(uint8_t pc)
+{
+  if (nCallDepth == ELEMENTS(aReturn))
+  {
+    bCallStackOverflow = TRUE;        // Too many calls without a return (probably
+    return pc;                        // a loop), so stop playing at this one
+  }
+  aReturn[nCallDepth++] = pc + 1;
+  return aAction[pc].jump.addr;
+}
+
+uint8_t runReturn(uint8_t pc)
+{
+  if (nCallDepth)
+    return aReturn[--nCallDepth];
+  return nAction;                     // A return without a call ends the program
+}
+
+const t_handler HANDLER[] =           // Indexed by OP_xxx
+{
+  runNothing,         // OP_NOP
+  runNothing,         // OP_DATA
+  runKeystroke,       // OP_KEYSTROKE
+  runSystemControl,   // OP_SYSTEM_CONTROL
+  runConsumer,        // OP_CONSUMER
+  runText,            // OP_TEXT
+  runInstruction,     // OP_INSTRUCTION
+  runJumpIf,          // OP_JUMP_IF
+  runJump,            // OP_JUMP
+  runJumpRelative,    // OP_JUMP_RELATIVE
+  runChain,           // OP_CHAIN
+  runCall,            // OP_CALL
+  runReturn,          // OP_RETURN
+  runRegister,        // OP_REGISTER
+  runLoop,            // OP_LOOP
+  runJumpIfNot,       // OP_JUMP_IF_NOT
+};
+
+void flashError()
+{
+  // Three flashes, each on 250 ms then off 250 ms. Timer0 ends the activity
+  // blinks within 44 ms, so it is kept from cutting these short
+  uint8_t i;
+  TMR0IE_bit = 0;
+  for (i = 0; i < 3; i++)
+  {
+    ACTIVITY_LED = ON;
+    pause(250);
+    ACTIVITY_LED = OFF;
+    pause(250);
+  }
+  TMR0IE_bit = 1;
+}
+
+void play()
+{
+  uint8_t pc;             // Program Counter (instruction address)
+  uint8_t nFirstProgram;
+  bUserInterrupt = FALSE; // The user can interrupt playback by pressing the button
+  nFirstProgram = nProgram;
+  nCallDepth = 0;
+  bCallStackOverflow = FALSE;
+  bChainRefused = FALSE;
+  decodeProgram();
+  pc = 0;
+  while (pc < nAction && !bUserInterrupt && !bCallStackOverflow && !bChainRefused)
+  {
+    ACTIVITY_LED = ON;         // The LED will be turned off by the next timer interrupt
+    sendReports();             // Keep earlier reports going out while this action runs
+    pc = HANDLER[aOp[pc]](pc);
   }
   sayNoKeyPressed();
+  if (bCallStackOverflow || bChainRefused) // Typing a message now would send it to whatever
+  {                       // has the focus, so flash the LED and leave it for PROGRAM mode
+    nStoppedAt = pc;
+    flashError();
+  }
+  if (nProgram != nFirstProgram)  // If playing chained to another program
+    loadProgram(nFirstProgram);   // Put back the one the knob plays
   if (bUserInterrupt)
   {
-    Delay_ms(5); // Wait for button press bouncing to subside
-    while (ROTARY_BUTTON_PRESSED); // Wait for user to release button
-    Delay_ms(5); // Wait for button release bouncing to subside
+    pause(5); // Wait for button press bouncing to subside
+    while (ROTARY_BUTTON_PRESSED)  // Wait for user to release button
+    {
+      sendReports();
+    }
+    pause(5); // Wait for button release bouncing to subside
   }
 }
 
@@ -1596,47 +2797,124 @@ void runMode()
 {
   if (ROTARY_BUTTON_PRESSED)
   {
-    Delay_ms(5);  // Cheap debounce
+    pause(5);  // Cheap debounce
     if (ROTARY_BUTTON_PRESSED)
     {
-      nRemainingTimerTicks = INTERVAL_IN_SECONDS(1);
-      TMR3ON_bit = 1; // Enable long-press timer
+      startTimer(INTERVAL_IN_SECONDS(1));  // Start long-press timer
       while (ROTARY_BUTTON_PRESSED)
       {
-        if (nRemainingTimerTicks == 0) // If it is a long press
+        sendReports();
+        if (isTimerExpired()) // If it is a long press
         {
           bProgramMode = TRUE;
-          TMR3ON_bit = 0;   // Disable long-press timer
+          stopTimer();  // Stop long-press timer
           displayProgrammingMenu();
           break;
         }
       }
-      TMR3ON_bit = 0;   // Disable long-press timer
-      Delay_ms(5);  // Cheap debounce
+      stopTimer();  // Stop long-press timer
+      pause(5);  // Cheap debounce
       if (!bProgramMode)
       {
+        beginMeasurement();
         play();
+        endMeasurement();
       }
     }
   }
 }
 
+void suspend()
+{
+  // The host suspends the bus by sending nothing at all (not even the
+  // start-of-frame every millisecond), and a suspended device must draw no
+  // more than 2.5 mA. So everything is stopped, Timer3 included, until
+  // there is activity on the bus again
+  ACTIVITY_LED = OFF;
+  SUSPND_bit = 1;                 // Put the USB transceiver into low power mode
+  bUSBResumed = FALSE;
+  ACTVIE_bit = 1;                 // Wake on bus activity
+  IDLEN_bit = 0;                  // Sleep rather than idle
+  while (!bUSBResumed)            // The knob can wake it too, but is ignored. ACTVIF
+    asm sleep;                    // itself may already have been cleared by USB_Interrupt_Proc()
+  IDLEN_bit = 1;
+  while (!OSTS_bit);              // Wait until the clock is running again
+  SUSPND_bit = 0;
+  while (ACTVIF_bit)              // It only stays clear once the USB clock is
+    ACTVIF_bit = 0;               // running again
+  ACTVIE_bit = 0;
+  IDLEIF_bit = 0;
+  ignoreSteps();                  // Forget knob turns made while asleep
+  bUserInterrupt = FALSE;
+}
+
+uint8_t isQuiet()
+{
+  return nReportHead == nReportTail && nStepHead == nStepTail && !rotation && !ROTARY_BUTTON_PRESSED;
+}
+
+void rest()
+{
+  // Idles until the next interrupt, if there is still nothing to do. Unless
+  // something is being timed (a long press, or knob steps that may be close
+  // enough together to accelerate), Timer3 and the Timer0 interrupt are
+  // stopped first, so that only the knob or the USB module wakes the CPU
+  // rather than the tick every millisecond. Interrupts are held off
+  // meanwhile, so that one arriving just before the SLEEP is not missed: it
+  // still wakes the CPU, and is handled once they are allowed again
+  uint8_t bTimed;
+  GIE_bit = 0;
+  if (isQuiet())
+  {
+    bTimed = bTimerRunning ||
+             (uint16_t)(nTickCount - nLastStepTime) < STEP_GAP[ELEMENTS(STEP_GAP) - 1];
+    if (!bTimed)
+    {
+      ACTIVITY_LED = OFF;         // As Timer0 would have
+      TMR0IE_bit = 0;
+      TMR3ON_bit = 0;             // nTickCount stands still until it is woken
+    }
+    asm sleep;
+    TMR3ON_bit = 1;
+    TMR0IE_bit = 1;
+  }
+  GIE_bit = 1;
+}
+
 void main()
 {
   uint8_t nRead;
   Prolog();
   while (1)
   {
-    if (HID_Read() == 2 && usbFromHost[0] == REPORT_ID_KEYBOARD)   // If a host LED indication response is available
+    nRead = HID_Read();
+    if (nRead == 2 && usbFromHost[0] == REPORT_ID_KEYBOARD)   // If a host LED indication response is available
     {
       leds.byte = usbFromHost[1];   // Remember the most recent LED status change
     }
+    else if (nRead == 1+sizeof(t_programReport) && usbFromHost[0] == REPORT_ID_PROGRAM) // If a host program request is available
+    {
+      doProgramCommand((t_programReport *)&usbFromHost[1]);
+    }
+    sendReports();                  // Send any reports still queued for the host
     bProgramMode ? programMode() : runMode();
+    if (bUSBReady && IDLEIF_bit)    // If the host has suspended the bus
+      suspend();
+    else                            // Else wait for the next interrupt if
+      rest();                       // nothing is waiting to be done
   }
 }
 
 void interrupt()               // High priority interrupt service routine
 {
+  uint16_t t;
+  uint8_t last;
+  uint8_t i;
+  int8_t step;
+  int16_t weight;
+
+  if (ACTVIE_bit && ACTVIF_bit) // Note bus activity for suspend() before the USB
+    bUSBResumed = TRUE;        // module gets the chance to clear it
   USB_Interrupt_Proc();        // Always give the USB module first opportunity to process
 
   if (IOCIF_bit)               // Interrupt On Change interrupt?
@@ -1646,7 +2924,35 @@ void interrupt()               // High priority interrupt service routine
       bUserInterrupt = TRUE;
     }
     state = *(stateArray + ((state & STATE_MASK) << 2 | (ROTARY_B << 1 | ROTARY_A)));
-    rotation |= state & EVENT_MASK; // Extract rotary event from encoder state
+    if (state & EVENT_MASK)    // If a step has been completed
+    {
+      step = (state & EVENT_MASK) == DIR_CW ? 1 : -1;
+      weight = 1;
+      for (i = 0; i < ELEMENTS(STEP_GAP); i++)
+      {
+        if (nTickCount - nLastStepTime < STEP_GAP[i]) // The faster the turn, the further it goes
+        {
+          weight = STEP_WEIGHT[i];
+          break;
+        }
+      }
+      nLastStepTime = nTickCount;
+      if (step < 0)
+        weight = -weight;
+      last = (nStepTail - 1) & (STEP_QUEUE_SIZE - 1);
+      if (nStepHead != nStepTail && (aSteps[last] > 0) == (step > 0) &&
+          aSteps[last] != 127 && aSteps[last] != -127)
+      {
+        aSteps[last] += step;  // Add to the newest entry (the main loop has not claimed it yet)
+        aDistance[last] += weight;
+      }
+      else if (((nStepTail + 1) & (STEP_QUEUE_SIZE - 1)) != nStepHead)
+      {
+        aSteps[nStepTail] = step; // Start a new entry (lost only if the direction
+        aDistance[nStepTail] = weight; // changed 7 times meanwhile)
+        nStepTail = (nStepTail + 1) & (STEP_QUEUE_SIZE - 1);
+      }
+    }
     IOCIF_bit = 0;             // Clear Interrupt On Change flag
   }
   if (TMR0IF_bit)              // Timer0 interrupt? (22.9 times/second)
@@ -1654,9 +2960,15 @@ void interrupt()               // High priority interrupt service routine
     ACTIVITY_LED = OFF;        // Always turn the LED off after at most 44 ms
     TMR0IF_bit = 0;            // Clear the Timer0 interrupt flag
   }
-  if (TMR3IF_bit)              // Timer3 interrupt? (22.9 times/second)
+  if (TMR3IF_bit)              // Timer3 interrupt? (every millisecond)
   {
-    nRemainingTimerTicks--;    // Decrement delay count
+    Lo(t) = TMR3L;             // Time the next millisecond from when this one ended,
+    Hi(t) = TMR3H;             // not from now, so that interrupt latency does not
+    t += TIMER3_RELOAD;        // add up
+    TMR3H = Hi(t);             // The high byte is written when the low byte is
+    TMR3L = Lo(t);
+    nTickCount++;              // Count milliseconds
+    stats.nMs++;               // Measure elapsed time
     TMR3IF_bit = 0;            // Clear the Timer3 interrupt flag
   }
 
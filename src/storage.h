@@ -0,0 +1,433 @@
+/*
+  PUB! Programmable USB Button
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// Where the programs are kept. Program n is kept in the region starting at
+// byte n * PROGRAM_REGION_SIZE of the storage, as two copies (see below).
+// Only the program being edited or played is held in RAM, and CHAIN loads
+// the next one when it is needed.
+//
+// Choose the storage by defining STORAGE before this file is included (the
+// on-chip EEPROM is used otherwise), and tick the I2C, SPI or FLASH library
+// that it needs in the project. STORAGE_FILE is for host programs, so that
+// the tools can simulate a device (see tools/pubprog.c).
+
+#define STORAGE_EEPROM  1   // 256-byte on-chip data EEPROM:    1 program
+#define STORAGE_24LC    2   // 24LC256 I2C EEPROM:              64 programs
+                            //   SDA=RB0 SCL=RB1 (pulled up), A2..A0=0
+#define STORAGE_25LC    3   // 25LC256 SPI EEPROM:              64 programs
+                            //   SI=RC7 SO=RB0 SCK=RB1 CS=RA1 (SDOMX=0)
+#define STORAGE_FLASH   4   // Unused program flash:            16 programs
+                            //   (FLASH_STORAGE reserves it, see below)
+#define STORAGE_FILE    5   // File named by sStorageFile:      64 programs
+
+#ifndef STORAGE
+#define STORAGE STORAGE_EEPROM
+#endif
+
+#if STORAGE == STORAGE_EEPROM
+  #define STORAGE_SIZE        256
+  #define PROGRAM_REGION_SIZE 256     // Room for two copies of 61 actions
+#elif STORAGE == STORAGE_24LC || STORAGE == STORAGE_25LC
+  #define STORAGE_SIZE        32768
+  #define STORAGE_ROW_SIZE    64      // Page write size
+#elif STORAGE == STORAGE_FLASH
+  #define FLASH_STORAGE_START 0x6000
+  #define STORAGE_SIZE        8192    // Up to the end of the 32 KB flash
+  #define STORAGE_ROW_SIZE    64      // Erase and write block size
+#elif STORAGE == STORAGE_FILE
+  #include <stdio.h>
+  #define STORAGE_SIZE        32768
+  #define STORAGE_ROW_SIZE    64      // Same as the EEPROMs, to exercise the row cache
+#endif
+
+#ifndef PROGRAM_REGION_SIZE
+#define PROGRAM_REGION_SIZE   512     // Room for two whole copies
+#endif
+
+#define PROGRAM_SLOTS (STORAGE_SIZE / PROGRAM_REGION_SIZE)
+
+#ifndef countStorageWrites
+#define countStorageWrites(n)         // Hook for counting the bytes written
+#endif
+
+
+#if STORAGE == STORAGE_EEPROM
+
+void storageInit()
+{
+}
+
+uint8_t storageRead(uint16_t addr)
+{
+  return EEPROM_Read(addr);
+}
+
+void storageWrite(uint16_t addr, uint8_t b)
+{
+  if (EEPROM_Read(addr) != b)     // Each byte takes about 4 ms to write, so
+  {                               // only write the bytes that change
+    EEPROM_Write(addr, b);
+    countStorageWrites(1);
+  }
+}
+
+void storageFlush()
+{
+}
+
+#else
+
+// The other storage is read and written a row at a time, through a cache
+// holding one row, so that a program is saved with a few page writes (or
+// flash erase/write cycles) instead of one write for every byte.
+
+#if STORAGE == STORAGE_24LC
+
+#define EEPROM_24LC_ADDRESS 0xA0    // Control byte for writing (add 1 to read)
+
+void storageInit()
+{
+  TRISB0_bit = 1;                   // SDA and SCL are driven by the MSSP
+  TRISB1_bit = 1;
+  I2C1_Init(400000);
+}
+
+void selectAddress24LC(uint16_t addr)
+{
+  do                                // Poll until any earlier write is done
+  {
+    I2C1_Start();
+  } while (I2C1_Wr(EEPROM_24LC_ADDRESS));
+  I2C1_Wr(Hi(addr));
+  I2C1_Wr(Lo(addr));
+}
+
+void storageReadRow(uint16_t addr, uint8_t * p)
+{
+  uint8_t i;
+  selectAddress24LC(addr);
+  I2C1_Repeated_Start();
+  I2C1_Wr(EEPROM_24LC_ADDRESS + 1);
+  for (i = 0; i < STORAGE_ROW_SIZE; i++)
+  {
+    *p++ = I2C1_Rd(i < STORAGE_ROW_SIZE-1); // Acknowledge all but the last byte
+  }
+  I2C1_Stop();
+}
+
+void storageWriteRow(uint16_t addr, uint8_t * p)
+{
+  uint8_t i;
+  selectAddress24LC(addr);
+  for (i = 0; i < STORAGE_ROW_SIZE; i++)
+  {
+    I2C1_Wr(*p++);
+  }
+  I2C1_Stop();                      // Starts the page write (polled for later)
+}
+
+#elif STORAGE == STORAGE_25LC
+
+#define EEPROM_25LC_READ    0x03
+#define EEPROM_25LC_WRITE   0x02
+#define EEPROM_25LC_WREN    0x06
+#define EEPROM_25LC_RDSR    0x05
+#define EEPROM_25LC_WIP     0x01    // Write In Progress status bit
+
+sbit EEPROM_25LC_CS           at LATA1_bit;
+sbit EEPROM_25LC_CS_Direction at TRISA1_bit;
+
+void storageInit()
+{
+  EEPROM_25LC_CS = 1;
+  EEPROM_25LC_CS_Direction = OUTPUT;
+  TRISB0_bit = 1;                   // SDI
+  TRISB1_bit = 0;                   // SCK
+  TRISC7_bit = 0;                   // SDO (on RC7 because CONFIG3H SDOMX=0)
+  SPI1_Init_Advanced(_SPI_MASTER_OSC_DIV16, _SPI_DATA_SAMPLE_MIDDLE, _SPI_CLK_IDLE_LOW, _SPI_LOW_2_HIGH);
+}
+
+void selectAddress25LC(uint8_t command, uint16_t addr)
+{
+  uint8_t status;
+  do                                // Wait until any earlier write is done
+  {
+    EEPROM_25LC_CS = 0;
+    SPI1_Write(EEPROM_25LC_RDSR);
+    status = SPI1_Read(0);
+    EEPROM_25LC_CS = 1;
+  } while (status & EEPROM_25LC_WIP);
+  if (command == EEPROM_25LC_WRITE)
+  {
+    EEPROM_25LC_CS = 0;
+    SPI1_Write(EEPROM_25LC_WREN);
+    EEPROM_25LC_CS = 1;
+  }
+  EEPROM_25LC_CS = 0;
+  SPI1_Write(command);
+  SPI1_Write(Hi(addr));
+  SPI1_Write(Lo(addr));
+}
+
+void storageReadRow(uint16_t addr, uint8_t * p)
+{
+  uint8_t i;
+  selectAddress25LC(EEPROM_25LC_READ, addr);
+  for (i = 0; i < STORAGE_ROW_SIZE; i++)
+  {
+    *p++ = SPI1_Read(0);
+  }
+  EEPROM_25LC_CS = 1;
+}
+
+void storageWriteRow(uint16_t addr, uint8_t * p)
+{
+  uint8_t i;
+  selectAddress25LC(EEPROM_25LC_WRITE, addr);
+  for (i = 0; i < STORAGE_ROW_SIZE; i++)
+  {
+    SPI1_Write(*p++);
+  }
+  EEPROM_25LC_CS = 1;               // Starts the page write (polled for later)
+}
+
+#elif STORAGE == STORAGE_FLASH
+
+// The programs live in this ROM constant. Being absolute, it holds the range
+// for itself: the linker places no code or other constant there, and fails
+// the build if the firmware grows into it. Flashing the firmware fills it
+// with zeros, which load as no program.
+const uint8_t FLASH_STORAGE[STORAGE_SIZE] absolute FLASH_STORAGE_START = { 0 };
+
+void storageInit()
+{
+}
+
+void storageReadRow(uint16_t addr, uint8_t * p)
+{
+  uint8_t i;
+  for (i = 0; i < STORAGE_ROW_SIZE; i++)
+  {
+    *p++ = FLASH_STORAGE[addr + i];
+  }
+}
+
+void storageWriteRow(uint16_t addr, uint8_t * p)
+{
+  FLASH_Erase_64(FLASH_STORAGE_START + addr);
+  FLASH_Write_64(FLASH_STORAGE_START + addr, p);
+}
+
+#elif STORAGE == STORAGE_FILE
+
+const char * sStorageFile;          // Set by the host program
+FILE * fStorage;
+
+void storageInit()
+{
+  fStorage = fopen(sStorageFile, "r+b");
+  if (!fStorage)
+    fStorage = fopen(sStorageFile, "w+b");
+}
+
+void storageReadRow(uint16_t addr, uint8_t * p)
+{
+  size_t n = 0;
+  if (fStorage && !fseek(fStorage, addr, SEEK_SET))
+    n = fread(p, 1, STORAGE_ROW_SIZE, fStorage);
+  for (; n < STORAGE_ROW_SIZE; n++)
+    p[n] = 0xFF;                    // Past the end of the file reads as erased
+}
+
+void storageWriteRow(uint16_t addr, uint8_t * p)
+{
+  if (fStorage && !fseek(fStorage, addr, SEEK_SET))
+  {
+    fwrite(p, 1, STORAGE_ROW_SIZE, fStorage);
+    fflush(fStorage);
+  }
+}
+
+#endif
+
+uint8_t aStorageRow[STORAGE_ROW_SIZE];  // Copy of the row last read or written
+uint16_t nStorageRow;                   // Address of that row
+uint8_t bStorageRowValid;               // aStorageRow holds a row
+uint8_t bStorageRowDirty;               // aStorageRow has changes not yet written
+
+void storageFlush()
+{
+  // Writes any changes held in the row cache
+  if (bStorageRowDirty)
+  {
+    storageWriteRow(nStorageRow, aStorageRow);
+    countStorageWrites(STORAGE_ROW_SIZE);
+    bStorageRowDirty = 0;
+  }
+}
+
+void storageSelectRow(uint16_t addr)
+{
+  addr &= ~(STORAGE_ROW_SIZE-1);
+  if (!bStorageRowValid || addr != nStorageRow)
+  {
+    storageFlush();
+    storageReadRow(addr, aStorageRow);
+    nStorageRow = addr;
+    bStorageRowValid = 1;
+  }
+}
+
+uint8_t storageRead(uint16_t addr)
+{
+  storageSelectRow(addr);
+  return aStorageRow[addr & (STORAGE_ROW_SIZE-1)];
+}
+
+void storageWrite(uint16_t addr, uint8_t b)
+{
+  uint8_t * p;
+  storageSelectRow(addr);
+  p = &aStorageRow[addr & (STORAGE_ROW_SIZE-1)];
+  if (*p != b)                          // Rows that do not change are not written
+  {
+    *p = b;
+    bStorageRowDirty = 1;
+  }
+}
+
+#endif
+
+
+// Each copy of a program is a record:
+//
+//   Offset  Content
+//   ------  ---------------------------------------------------------
+//     00    RECORD_VERSION (erased storage reads as FF)
+//     01    Sequence number (the newer copy has the higher number)
+//     02    Focussed action
+//     03    Number of actions (n)
+//     04    Actions (high byte, low byte)
+//   4+2n    CRC-16 of all the bytes above (high byte, low byte)
+//
+// The copies start half a region apart and each save overwrites the older
+// copy, so the cells wear half as fast, and a save cut short by a power
+// cut leaves a bad CRC in the copy it was writing: the other copy is then
+// loaded instead. A copy never runs into the other one, so a program with
+// more actions than half a region holds is not saved. That only limits the
+// on-chip EEPROM, where the region is the whole 256 bytes (61 actions).
+
+#define RECORD_VERSION      0xA1
+#define RECORD_SIZE(n)      (6 + 2 * (n))
+#define MAX_SAVED_ACTIONS   ((PROGRAM_REGION_SIZE / 2 - RECORD_SIZE(0)) / 2)
+
+uint16_t getCopyAddress(uint8_t n, uint8_t nCopy, uint16_t offset)
+{
+  return (uint16_t)n * PROGRAM_REGION_SIZE +
+         ((nCopy * (PROGRAM_REGION_SIZE / 2) + offset) & (PROGRAM_REGION_SIZE - 1));
+}
+
+uint16_t updateCRC(uint16_t crc, uint8_t b)
+{
+  // CRC-16-CCITT (polynomial 0x1021), one bit at a time to save ROM
+  uint8_t i;
+  crc ^= (uint16_t)b << 8;
+  for (i = 0; i < 8; i++)
+  {
+    if (crc & 0x8000)
+      crc = (crc << 1) ^ 0x1021;
+    else
+      crc <<= 1;
+  }
+  return crc;
+}
+
+uint8_t isWholeCopy(uint8_t n, uint8_t nCopy)
+{
+  uint16_t crc;
+  uint16_t nSize;
+  uint16_t i;
+  uint8_t nCount;
+
+  if (storageRead(getCopyAddress(n, nCopy, 0)) != RECORD_VERSION)
+    return 0;
+  nCount = storageRead(getCopyAddress(n, nCopy, 3));
+  if (nCount > MAX_SAVED_ACTIONS)
+    return 0;
+  nSize = RECORD_SIZE(nCount) - 2;
+  crc = 0xFFFF;
+  for (i = 0; i < nSize; i++)
+  {
+    crc = updateCRC(crc, storageRead(getCopyAddress(n, nCopy, i)));
+  }
+  return storageRead(getCopyAddress(n, nCopy, nSize)) == (uint8_t)(crc >> 8) &&
+         storageRead(getCopyAddress(n, nCopy, nSize + 1)) == (uint8_t)crc;
+}
+
+int8_t findNewestCopy(uint8_t n)
+{
+  // Returns the copy of program n to load, or -1 if there is no whole copy
+  uint8_t b0;
+  uint8_t b1;
+  b0 = isWholeCopy(n, 0);
+  b1 = isWholeCopy(n, 1);
+  if (b0 && b1)
+  {
+    if ((int8_t)(storageRead(getCopyAddress(n, 1, 1)) - storageRead(getCopyAddress(n, 0, 1))) > 0)
+      return 1;
+    return 0;
+  }
+  if (b0)
+    return 0;
+  if (b1)
+    return 1;
+  return -1;
+}
+
+#if STORAGE == STORAGE_EEPROM
+// Firmware before 0.94 kept its one program in the on-chip EEPROM without
+// copies or a CRC:
+//
+//   Offset  Content
+//   ------  -------------------------------------------
+//     00    Focussed action
+//     01    Number of actions (at most 127)
+//     02    Actions (high byte, low byte)
+//
+// Any save in the record format writes RECORD_VERSION at the start of one
+// of the copies, and 0.93 never had it there (a focus is at most 127), so
+// the old layout is only read where no record was ever started.
+#define LEGACY_MAX_ACTIONS  127
+
+uint8_t isLegacyProgram()
+{
+  uint8_t nFocus;
+  uint8_t nCount;
+  if (storageRead(getCopyAddress(0, 0, 0)) == RECORD_VERSION ||
+      storageRead(getCopyAddress(0, 1, 0)) == RECORD_VERSION)
+    return 0;
+  nFocus = storageRead(0);
+  nCount = storageRead(1);
+  return nCount && nCount <= LEGACY_MAX_ACTIONS && nFocus <= nCount;
+}
+#endif
@@ -0,0 +1,479 @@
+/*
+  PUB! Programmable USB Button
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// The names of the keystrokes, system control and consumer device usages.
+// The host tools use these tables as they are. The device types its names
+// from the packed copy in usagetext.h instead, so after changing a name here
+// run tools/pubtext to make that file again. The system control and
+// consumer device names are paired with their usages, and pubtext also
+// makes the device's SYSTEM_CONTROL_USAGE and CONSUMER_DEVICE_USAGE from
+// them, so each usage list cannot drift from its names.
+
+typedef struct
+{
+  uint16_t usage;
+  const char * sName;
+} t_usageName;
+
+const char * const UNSHIFTED_USB_DESC[] =
+{
+  /* 00 */ "No Op", "",          "",         "",        "a",          "b",    "c",      "d",       "e",        "f",        "g",         "h",           "i",       "j",     "k",        "l",
+  /* 10 */ "m",     "n",         "o",        "p",       "q",          "r",    "s",      "t",       "u",        "v",        "w",         "x",           "y",       "z",     "1",        "2",
+  /* 20 */ "3",     "4",         "5",        "6",       "7",          "8",    "9",      "0",       "Enter",    "Esc",      "Backspace", "Tab",         "Space",   "-",     "=",        "[",
+  /* 30 */ "]",     "\\",        "#",        ";",       "'",          "`",    ",",      ".",       "/",        "CapsLock", "F1",        "F2",          "F3",      "F4",    "F5",       "F6",
+  /* 40 */ "F7",    "F8",        "F9",       "F10",     "F11",        "F12",  "PrtScr", "ScrLock", "Pause",    "Ins",      "Home",      "PageUp",      "Delete",  "End",   "PageDown", "Right",
+  /* 50 */ "Left",  "Down",      "Up",       "NumLock", "KP /",       "KP *", "KP -",   "KP +",    "KP Enter", "KP 1",     "KP 2",      "KP 3",        "KP 4",    "KP 5",  "KP 6",     "KP 7",
+  /* 60 */ "KP 8",  "KP 9",      "KP 0",     "KP .",    "\\",         "Appl", "Power",  "KP =",    "F13",      "F14",      "F15",       "F16",         "F17",     "F18",   "F19",      "F20",
+  /* 70 */ "F21",   "F22",       "F23",      "F24",     "Exec",       "Help", "Menu",   "Select",  "Stop",     "Again",    "Undo",      "Cut",         "Copy",    "Paste", "Find",     "Mute",
+  /* 80 */ "Vol+",  "Vol-",      "LockCaps", "LockNum", "LockScroll", "KP ,", "KP =",
+};
+
+const char * const SHIFTED_USB_DESC[] =
+{
+  /* 00 */ "",      "",          "",         "",        "A",          "B",    "C",      "D",       "E",        "F",        "G",         "H",           "I",       "J",     "K",        "L",
+  /* 10 */ "M",     "N",         "O",        "P",       "Q",          "R",    "S",      "T",       "U",        "V",        "W",         "X",           "Y",       "Z",     "!",        "@",
+  /* 20 */ "#",     "$",         "%",        "^",       "&",          "*",    "(",      ")",       "",         "",         "",          "",            "",        "_",     "+",        "{",
+  /* 30 */ "}",     "|",         "~",        ":",       "\"",         "~",    "<",      ">",       "?",        "",         "",          "",            "",        "",      "",         "",
+  /* 40 */ "",      "",          "",         "",        "",           "",     "",       "",        "",         "",         "",          "",            "",        "",      "",         "",
+  /* 50 */ "",      "",          "",         "Clear",   "",           "",     "",       "",        "",         "KP End",   "KP Down",   "KP PageDown", "KP Left", "",      "KP Right", "KP Home",
+  /* 60 */ "KP Up", "KP PageUp", "KP Ins",   "KP Del",  "|",
+};
+
+const t_usageName SYSTEM_CONTROL_DESC[] =  // Each named system control usage and its name, in ascending order of usage
+{
+// 81 System Power Down,OSC,
+// 82 System Sleep,OSC,
+// 83 System Wake Up,OSC,
+// 84 System Context Menu,OSC,
+// 85 System Main Menu,OSC,
+// 86 System App Menu,OSC,
+// 87 System Menu Help,OSC,
+// 88 System Menu Exit,OSC,
+// 89 System Menu Select,OSC,
+// 8A System Menu Right,RTC,
+// 8B System Menu Left,RTC,
+// 8C System Menu Up,RTC,
+// 8D System Menu Down,RTC,
+// 8E System Cold Restart,OSC,
+// 8F System Warm Restart,OSC,
+  {0x01, "Power Down"}, {0x02, "Sleep"}, {0x03, "Wake Up"}, {0x04, "Context Menu"}, {0x05, "App Menu"}, {0x06, "Menu Help"}, {0x07, "Menu Exit"}, {0x08, "Menu Select"}, {0x09, "Menu Right"}, {0x0A, "Menu Left"}, {0x0B, "Menu Up"}, {0x0C, "Menu Down"}, {0x0D, "Cold Restart"}, {0x0E, "Warm Restart"},
+};
+
+const t_usageName CONSUMER_DEVICE_DESC[] =  // Each named consumer device usage and its name, in ascending order of usage
+{
+// 00 Unassigned
+// 01 Consumer Control,CA,
+// 02 Numeric Key Pad,NAry,
+// 03 Programmable Buttons,NAry,
+// 04 Microphone,CA,
+// 05 Headphone,CA,
+// 06 Graphic Equalizer,CA,
+// 20 +10,OSC,Plus10
+// 21 +100,OSC,Plus100
+// 22 AM/PM,OSC,
+// 30 Power,OOC,
+// 31 Reset,OSC,
+// 32 Sleep,OSC,
+// 33 Sleep After,OSC,
+// 34 Sleep Mode,RTC,
+// 35 Illumination,OOC,
+// 36 Function Buttons,NAry,
+// 40 Menu,OOC,
+// 41 Menu Pick,OSC,
+// 42 Menu Up,OSC,
+// 43 Menu Down,OSC,
+// 44 Menu Left,OSC,
+// 45 Menu Right,OSC,
+// 46 Menu Escape,OSC,
+// 47 Menu Value Increase,OSC,
+// 48 Menu Value Decrease,OSC,
+// 60 Data On Screen,OOC,
+// 61 Closed Caption,OOC,
+// 62 Closed Caption Select,OSC,
+// 63 VCR/TV,OOC,
+// 64 Broadcast Mode,OSC,
+// 65 Snapshot,OSC,
+// 66 Still,OSC,
+// 67 Picture-in-Picture Toggle,OSC,
+// 68 Picture-in-Picture Swap,OSC,
+// 69 Red Menu Button,MC,
+// 6A Green Menu Button,MC,
+// 6B Blue Menu Button,MC,
+// 6C Yellow Menu Button,MC,
+// 6D Aspect,OSC,
+// 6E 3D Mode Select,OSC,
+// 6F Display Brightness Increment,RTC,
+// 70 Display Brightness Decrement,RTC,
+// 71 Display Brightness,LC,
+// 72 Display Backlight Toggle,OOC,
+// 73 Display Set Brightness to Minimum,OOC,
+// 74 Display Set Brightness to Maximum,OOC,
+// 75 Display Set Auto Brightness,OOC,
+// 80 Selection,NAry,
+// 81 Assign Selection,OSC,
+// 82 Mode Step,OSC,
+// 83 Recall Last,OSC,
+// 84 Enter Channel,OSC,
+// 85 Order Movie,OSC,
+// 86 Channel,LC,
+// 87 Media Selection,NAry,
+// 88 Media Select Computer,Sel,
+// 89 Media Select TV,Sel,
+// 8A Media Select WWW,Sel,
+// 8B Media Select DVD,Sel,
+// 8C Media Select Telephone,Sel,
+// 8D Media Select Program Guide,Sel,
+// 8E Media Select Video Phone,Sel,
+// 8F Media Select Games,Sel,
+// 90 Media Select Messages,Sel,
+// 91 Media Select CD,Sel,
+// 92 Media Select VCR,Sel,
+// 93 Media Select Tuner,Sel,
+// 94 Quit,OSC,
+// 95 Help,OOC,
+// 96 Media Select Tape,Sel,
+// 97 Media Select Cable,Sel,
+// 98 Media Select Satellite,Sel,
+// 99 Media Select Security,Sel,
+// 9A Media Select Home,Sel,
+// 9B Media Select Call,Sel,
+// 9C Channel Increment,OSC,
+// 9D Channel Decrement,OSC,
+// 9E Media Select SAP,Sel,
+  {0x09D, "Ch+"}, {0x09E, "Ch-"},
+// A0 VCR Plus,OSC,
+// A1 Once,OSC,
+// A2 Daily,OSC,
+// A3 Weekly,OSC,
+// A4 Monthly,OSC,
+// B0 Play,OOC,
+// B1 Pause,OOC,
+// B2 Record,OOC,
+// B3 Fast Forward,OOC,
+// B4 Rewind,OOC,
+// B5 Scan Next Track,OSC,
+// B6 Scan Previous Track,OSC,
+// B7 Stop,OSC,
+// B8 Eject,OSC,
+// B9 Random Play,OOC,
+// BA Select Disc,NAry,
+// BB Enter Disc,MC,
+// BC Repeat,OSC,
+// BD Tracking,LC,
+// BE Track Normal,OSC,
+// BF Slow Tracking,LC,
+  {0x0B0, "Play"}, {0x0B1, "Pause"}, {0x0B2, "Record"}, {0x0B3, "FF"}, {0x0B4, "Rew"}, {0x0B5, "Next Track"}, {0x0B6, "Prev Track"}, {0x0B7, "Stop"}, {0x0B8, "Eject"}, {0x0B9, "Random"}, {0x0BC, "Repeat"},
+// C0 Frame Forward,RTC,
+// C1 Frame Back,RTC,
+// C2 Mark,OSC,
+// C3 Clear Mark,OSC,
+// C4 Repeat From Mark,OOC,
+// C5 Return To Mark,OSC,
+// C6 Search Mark Forward,OSC,
+// C7 Search Mark Backwards,OSC,
+// C8 Counter Reset,OSC,
+// C9 Show Counter,OSC,
+// CA Tracking Increment,RTC,
+// CB Tracking Decrement,RTC,
+// CC Stop/Eject,OSC,
+// CD Play/Pause,OSC,
+// CE Play/Skip,OSC,
+// CF Voice Command,OSC,
+  {0x0CC, "Stop/Eject"}, {0x0CD, "Play/Pause"},
+// E0 Volume,LC,
+// E1 Balance,LC,
+// E2 Mute,OOC,
+// E3 Bass,LC,
+// E4 Treble,LC,
+// E5 Bass Boost,OOC,
+// E6 Surround Mode,OSC,
+// E7 Loudness,OOC,
+// E8 MPX,OOC,MPX
+// E9 Volume Increment,RTC,
+// EA Volume Decrement,RTC,
+  {0x0E2, "Mute"}, {0x0E5, "Bass Boost"}, {0x0E6, "Surround"}, {0x0E7, "Loudness"}, {0x0E8, "MPX"}, {0x0E9, "Vol+"}, {0x0EA, "Vol-"},
+// F0 Speed Select,OSC,
+// F1 Playback Speed,NAry,
+// F2 Standard Play,Sel,
+// F3 Long Play,Sel,
+// F4 Extended Play,Sel,
+// F5 Slow,OSC,
+  {0x0F5, "Slow"},
+// 100 Fan Enable,OOC,
+// 101 Fan Speed,LC,
+// 102 Light Enable,OOC,
+// 103 Light Illumination Level,LC,
+// 104 Climate Control Enable,OOC,
+// 105 Room Temperature,LC,
+// 106 Security Enable,OOC,
+// 107 Fire Alarm,OSC,
+// 108 Police Alarm,OSC,
+// 109 Proximity,LC,
+// 10A Motion,OSC,
+// 10B Duress Alarm,OSC,
+// 10C Holdup Alarm,OSC,
+// 10D Medical Alarm,OSC,
+// 150 Balance Right,RTC,
+// 151 Balance Left,RTC,
+// 152 Bass Increment,RTC,
+// 153 Bass Decrement,RTC,
+// 154 Treble Increment,RTC,
+// 155 Treble Decrement,RTC,
+// 160 Speaker System,CL,
+// 161 Channel Left,CL,
+// 162 Channel Right,CL,
+// 163 Channel Center,CL,
+// 164 Channel Front,CL,
+// 165 Channel Center Front,CL,
+// 166 Channel Side,CL,
+// 167 Channel Surround,CL,
+// 168 Channel Low Frequency Enhancement,CL,
+// 169 Channel Top,CL,
+// 16A Channel Unknown,CL,
+// 170 Sub-channel,LC,
+// 171 Sub-channel Increment,OSC,
+// 172 Sub-channel Decrement,OSC,
+// 173 Alternate Audio Increment,OSC,
+// 174 Alternate Audio Decrement,OSC,
+// 180 Application Launch Buttons,NAry,
+// 181 AL Launch Button Configuration Tool,Sel,
+// 182 AL Programmable Button Configuration,Sel,
+// 183 AL Consumer Control Configuration,Sel,
+// 184 AL Word Processor,Sel,
+// 185 AL Text Editor,Sel,
+// 186 AL Spreadsheet,Sel,
+// 187 AL Graphics Editor,Sel,
+// 188 AL Presentation App,Sel,
+// 189 AL Database App,Sel,
+// 18A AL Email Reader,Sel,
+// 18B AL Newsreader,Sel,
+// 18C AL Voicemail,Sel,
+// 18D AL Contacts/Address Book,Sel,
+// 18E AL Calendar/Schedule,Sel,
+// 18F AL Task/Project Manager,Sel,
+  {0x184, "Word Processor"}, {0x185, "Text Editor"}, {0x186, "Spreadsheet"}, {0x187, "Graphics Editor"}, {0x188, "Presentation"}, {0x189, "Database"}, {0x18A, "Email"}, {0x18B, "News"}, {0x18C, "Voicemail"}, {0x18D, "Contacts"}, {0x18E, "Calendar"}, {0x18F, "Project Manager"},
+// 190 AL Log/Journal/Timecard,Sel,
+// 191 AL Checkbook/Finance,Sel,
+// 192 AL Calculator,Sel,
+// 193 AL A/V Capture/Playback,Sel,
+// 194 AL Local Machine Browser,Sel,
+// 195 AL LAN/WAN Browser,Sel,
+// 196 AL Internet Browser,Sel,
+// 197 AL Remote Networking/ISP Connect,Sel,
+// 198 AL Network Conference,Sel,
+// 199 AL Network Chat,Sel,
+// 19A AL Telephony/Dialer,Sel,
+// 19B AL Logon,Sel,
+// 19C AL Logoff,Sel,
+// 19D AL Logon/Logoff,Sel,
+// 19E AL Terminal Lock/Screensaver,Sel,
+// 19F AL Control Panel,Sel,
+  {0x192, "Calculator"}, {0x196, "Web Browser"}, {0x19A, "Telephony"}, {0x19B, "Logon"}, {0x19C, "Logoff"}, {0x19E, "Terminal Lock"}, {0x19F, "Control Panel"},
+// 1A0 AL Command Line Processor/Run,Sel,
+// 1A1 AL Process/Task Manager,Sel,
+// 1A2 AL Select Task/Application,Sel,
+// 1A3 AL Next Task/Application,Sel,
+// 1A4 AL Previous Task/Application,Sel,
+// 1A5 AL Preemptive Halt Task/Application,Sel,
+// 1A6 AL Integrated Help Center,Sel,
+// 1A7 AL Documents,Sel,
+// 1A8 AL Thesaurus,Sel,
+// 1A9 AL Dictionary,Sel,
+// 1AA AL Desktop,Sel,
+// 1AB AL Spell Check,Sel,
+// 1AC AL Grammar Check,Sel,
+// 1AD AL Wireless Status,Sel,
+// 1AE AL Keyboard Layout,Sel,
+// 1AF AL Virus Protection,Sel,
+  {0x1A0, "Command Line"}, {0x1A1, "Task Manager"}, {0x1AA, "Desktop"},
+// 1B0 AL Encryption,Sel,
+// 1B1 AL Screen Saver,Sel,
+// 1B2 AL Alarms,Sel,
+// 1B3 AL Clock,Sel,
+// 1B4 AL File Browser,Sel,
+// 1B5 AL Power Status,Sel,
+// 1B6 AL Image Browser,Sel,
+// 1B7 AL Audio Browser,Sel,
+// 1B8 AL Movie Browser,Sel,
+// 1B9 AL Digital Rights Manager,Sel,
+// 1BA AL Digital Wallet,Sel,
+// 1BC AL Instant Messaging,Sel,
+// 1BD AL OEM Features/Tips/Tutorial Browser,Sel,
+// 1BE AL OEM Help,Sel,
+// 1BF AL Online Community,Sel,
+  {0x1B3, "Clock"}, {0x1B4, "File Browser"}, {0x1B6, "Image Browser"}, {0x1B7, "Audio Browser"}, {0x1B8, "Movie Browser"}, {0x1BB, "Messaging"},
+// 1C0 AL Entertainment Content Browser,Sel,
+// 1C1 AL Online Shopping Browser,Sel,
+// 1C2 AL SmartCard Information/Help,Sel,
+// 1C3 AL Market Monitor/Finance Browser,Sel,
+// 1C4 AL Customized Corporate News Browser,Sel,
+// 1C5 AL Online Activity Browser,Sel,
+// 1C6 AL Research/Search Browser,Sel,
+// 1C7 AL Audio Player,Sel,
+  {0x1C6, "Audio Player"},
+// 200 Generic GUI Application Controls,NAry,
+// 201 AC New,Sel,
+// 202 AC Open,Sel,
+// 203 AC Close,Sel,
+// 204 AC Exit,Sel,
+// 205 AC Maximize,Sel,
+// 206 AC Minimize,Sel,
+// 207 AC Save,Sel,
+// 208 AC Print,Sel,
+// 209 AC Properties,Sel,
+  {0x201, "New"}, {0x202, "Open"}, {0x203, "Close"}, {0x204, "Exit"}, {0x205, "Maximise"}, {0x206, "Minimise"}, {0x207, "Save"}, {0x208, "Print"},
+// 21A AC Undo,Sel,
+// 21B AC Copy,Sel,
+// 21C AC Cut,Sel,
+// 21D AC Paste,Sel,
+// 21E AC Select All,Sel,
+// 21F AC Find,Sel,
+  {0x21A, "Undo"}, {0x21B, "Copy"}, {0x21C, "Cut"}, {0x21D, "Paste"}, {0x21E, "Select All"}, {0x21F, "Find"},
+// 220 AC Find and Replace,Sel,
+// 221 AC Search,Sel,
+// 222 AC Go To,Sel,
+// 223 AC Home,Sel,
+// 224 AC Back,Sel,
+// 225 AC Forward,Sel,
+// 226 AC Stop,Sel,
+// 227 AC Refresh,Sel,
+// 228 AC Previous Link,Sel,
+// 229 AC Next Link,Sel,
+// 22A AC Bookmarks,Sel,
+// 22B AC History,Sel,
+// 22C AC Subscriptions,Sel,
+// 22D AC Zoom In,Sel,
+// 22E AC Zoom Out,Sel,
+// 22F AC Zoom,LC,
+  {0x220, "Replace"}, {0x221, "Search"}, {0x222, "Go To"}, {0x223, "Home"}, {0x224, "Back"}, {0x225, "Forward"}, {0x226, "Stop"}, {0x227, "Refresh"}, {0x228, "Prev Link"}, {0x229, "Next Link"}, {0x22A, "Bookmarks"}, {0x22B, "History"}, {0x22D, "Zoom In"}, {0x22E, "Zoom Out"},
+// 230 AC Full Screen View,Sel,
+// 231 AC Normal View,Sel,
+// 232 AC View Toggle,Sel,
+// 233 AC Scroll Up,Sel,
+// 234 AC Scroll Down,Sel,
+// 235 AC Scroll,LC,
+// 236 AC Pan Left,Sel,
+// 237 AC Pan Right,Sel,
+// 238 AC Pan,LC,
+// 239 AC New Window,Sel,
+// 23A AC Tile Horizontally,Sel,
+// 23B AC Tile Vertically,Sel,
+// 23C AC Format,Sel,
+// 23D AC Edit,Sel,
+// 23E AC Bold,Sel,
+// 23F AC Italics,Sel,
+  {0x230, "Full Screen"}, {0x231, "Normal View"}, {0x232, "Toggle View"}, {0x233, "Scroll Up"}, {0x234, "Scroll Down"}, {0x239, "New Window"}, {0x23A, "Tile Horz"}, {0x23B, "Tile Vert"},
+// 240 AC Underline,Sel,
+// 241 AC Strikethrough,Sel,
+// 242 AC Subscript,Sel,
+// 243 AC Superscript,Sel,
+// 244 AC All Caps,Sel,
+// 245 AC Rotate,Sel,
+// 246 AC Resize,Sel,
+// 247 AC Flip horizontal,Sel,
+// 248 AC Flip Vertical,Sel,
+// 249 AC Mirror Horizontal,Sel,
+// 24A AC Mirror Vertical,Sel,
+// 24B AC Font Select,Sel,
+// 24C AC Font Color,Sel,
+// 24D AC Font Size,Sel,
+// 24E AC Justify Left,Sel,
+// 24F AC Justify Center H,Sel,
+// 250 AC Justify Right,Sel,
+// 251 AC Justify Block H,Sel,
+// 252 AC Justify Top,Sel,
+// 253 AC Justify Center V,Sel,
+// 254 AC Justify Bottom,Sel,
+// 255 AC Justify Block V,Sel,
+// 256 AC Indent Decrease,Sel,
+// 257 AC Indent Increase,Sel,
+// 258 AC Numbered List,Sel,
+// 259 AC Restart Numbering,Sel,
+// 25A AC Bulleted List,Sel,
+// 25B AC Promote,Sel,
+// 25C AC Demote,Sel,
+// 25D AC Yes,Sel,
+// 25E AC No,Sel,
+// 25F AC Cancel,Sel,
+// 260 AC Catalog,Sel,
+// 261 AC Buy/Checkout,Sel,
+// 262 AC Add to Cart,Sel,
+// 263 AC Expand,Sel,
+// 264 AC Expand All,Sel,
+// 265 AC Collapse,Sel,
+// 266 AC Collapse All,Sel,
+// 267 AC Print Preview,Sel,
+// 268 AC Paste Special,Sel,
+// 269 AC Insert Mode,Sel,
+// 26A AC Delete,Sel,
+// 26B AC Lock,Sel,
+// 26C AC Unlock,Sel,
+// 26D AC Protect,Sel,
+// 26E AC Unprotect,Sel,
+// 26F AC Attach Comment,Sel,
+// 270 AC Delete Comment,Sel,
+// 271 AC View Comment,Sel,
+// 272 AC Select Word,Sel,
+// 273 AC Select Sentence,Sel,
+// 274 AC Select Paragraph,Sel,
+// 275 AC Select Column,Sel,
+// 276 AC Select Row,Sel,
+// 277 AC Select Table,Sel,
+// 278 AC Select Object,Sel,
+// 279 AC Redo/Repeat,Sel,
+// 27A AC Sort,Sel,
+// 27B AC Sort Ascending,Sel,
+// 27C AC Sort Descending,Sel,
+// 27D AC Filter,Sel,
+// 27E AC Set Clock,Sel,
+// 27F AC View Clock,Sel,
+// 280 AC Select Time Zone,Sel,
+// 281 AC Edit Time Zones,Sel,
+// 282 AC Set Alarm,Sel,
+// 283 AC Clear Alarm,Sel,
+// 284 AC Snooze Alarm,Sel,
+// 285 AC Reset Alarm,Sel,
+// 286 AC Synchronize,Sel,
+// 287 AC Send/Receive,Sel,
+// 288 AC Send To,Sel,
+// 289 AC Reply,Sel,
+// 28A AC Reply All,Sel,
+// 28B AC Forward Msg,Sel,
+// 28C AC Send,Sel,
+// 28D AC Attach File,Sel,
+// 28E AC Upload,Sel,
+// 28F AC Download (Save Target As),Sel,
+// 290 AC Set Borders,Sel,
+// 291 AC Insert Row,Sel,
+// 292 AC Insert Column,Sel,
+// 293 AC Insert File,Sel,
+// 294 AC Insert Picture,Sel,
+// 295 AC Insert Object,Sel,
+// 296 AC Insert Symbol,Sel,
+// 297 AC Save and Close,Sel,
+// 298 AC Rename,Sel,
+// 299 AC Merge,Sel,
+// 29A AC Split,Sel,
+// 29B AC Distribute Horizontally,Sel,
+// 29C AC Distribute Vertically,Sel,
+};
@@ -0,0 +1,350 @@
+// Generated by tools/pubtext from usagenames.h - do not edit.
+//
+// The usage names packed into one pool (see tools/pubtext.c). A name is a
+// run of bytes ended by 0: a byte below 0x80 is a character, and 0x80+n is
+// token n, the fragment at USAGE_TOKEN[n]. Offset 0 is the empty name.
+// SYSTEM_CONTROL_USAGE and CONSUMER_DEVICE_USAGE are the usages that have
+// names, in ascending order, and the _TEXT arrays after them their names.
+
+const uint8_t USAGE_TEXT[] =
+{
+  /* 0000 */ 0,
+  /* 0001 */ 'G', 'r', 'a', 'p', 'h', 'i', 'c', 's', ' ', 'E', 'd', 'i', 't', 0x8B, 0, // "Graphics Edit[or]"
+  /* 0010 */ 'F', 'u', 'l', 'l', ' ', 'S', 'c', 'r', 'e', 'e', 'n', 0, // "Full Screen"
+  /* 001C */ 'S', 'p', 'r', 'e', 'a', 'd', 's', 'h', 'e', 'e', 't', 0, // "Spreadsheet"
+  /* 0028 */ 'W', 0x8B, 'd', ' ', 0x92, 'o', 'c', 'e', 's', 's', 0x8B, 0, // "W[or]d [Pr]ocess[or]"
+  /* 0034 */ 'B', 'a', 's', 's', ' ', 'B', 'o', 'o', 's', 't', 0, // "Bass Boost"
+  /* 003F */ 'T', 'a', 's', 'k', ' ', 'M', 'a', 'n', 0x85, 'r', 0, // "Task Man[age]r"
+  /* 004A */ 0x8F, 'r', 'o', 'l', ' ', 'P', 'a', 'n', 'e', 'l', 0, // "[Cont]rol Panel"
+  /* 0055 */ 0x92, 'e', 0x97, 'n', 't', 'a', 't', 'i', 'o', 'n', 0, // "[Pr]e[se]ntation"
+  /* 0060 */ 'C', 'a', 'l', 'c', 'u', 'l', 'a', 't', 0x8B, 0, // "Calculat[or]"
+  /* 006A */ 'C', 0x9B, 'm', 'a', 0x96, ' ', 'L', 0x8A, 'e', 0, // "C[om]ma[nd] L[in]e"
+  /* 0074 */ 'N', 0x8B, 'm', 'a', 'l', ' ', 'V', 'i', 0x9A, 0, // "N[or]mal Vi[ew]"
+  /* 007E */ 'S', 'e', 0x86, 'c', 't', ' ', 'A', 'l', 'l', 0, // "Se[le]ct All"
+  /* 0088 */ 'T', 'o', 'g', 'g', 0x86, ' ', 'V', 'i', 0x9A, 0, // "Togg[le] Vi[ew]"
+  /* 0092 */ 'V', 'o', 'i', 'c', 'e', 'm', 'a', 'i', 'l', 0, // "Voicemail"
+  /* 009C */ 0x92, 'o', 0x95, ' ', 'M', 'a', 'n', 0x85, 'r', 0, // "[Pr]o[ject] Man[age]r"
+  /* 00A6 */ ' ', 'B', 'r', 'o', 'w', 's', 'e', 'r', 0,     // Token 81: " Browser"
+  /* 00AF */ ' ', 'R', 'e', 's', 't', 'a', 'r', 't', 0,     // Token 8D: " Restart"
+  /* 00B8 */ 'A', 'u', 'd', 'i', 'o', ' ', 0x91, 0x94, 0,   // "Audio [Play][er]"
+  /* 00C1 */ 'B', 'o', 'o', 'k', 'm', 0x99, 'k', 's', 0,    // "Bookm[ar]ks"
+  /* 00CA */ 'L', 'o', 'u', 'd', 'n', 'e', 's', 's', 0,     // "Loudness"
+  /* 00D3 */ 'M', 'e', 's', 's', 'a', 'g', 0x8A, 'g', 0,    // "Messag[in]g"
+  /* 00DC */ 'N', 0x9A, ' ', 'W', 0x8A, 'd', 'o', 'w', 0,   // "N[ew] W[in]dow"
+  /* 00E5 */ 'T', 'e', 0x86, 'p', 'h', 'o', 'n', 'y', 0,    // "Te[le]phony"
+  /* 00EE */ 'T', 0x94, 'm', 0x8A, 'a', 'l', ' ', 0x84, 0,  // "T[er]m[in]al [Lock]"
+  /* 00F7 */ 0x92, 'e', 'v', ' ', 'T', 'r', 0x8E, 'k', 0,   // "[Pr]ev Tr[ac]k"
+  /* 0100 */ 'B', 0x8E, 'k', 's', 'p', 0x8E, 'e', 0,        // "B[ac]ksp[ac]e"
+  /* 0108 */ 'D', 'a', 't', 'a', 'b', 'a', 0x97, 0,         // "Databa[se]"
+  /* 0110 */ 'D', 'e', 's', 'k', 't', 'o', 'p', 0,          // "Desktop"
+  /* 0118 */ 'M', 'a', 'x', 'i', 'm', 'i', 0x97, 0,         // "Maximi[se]"
+  /* 0120 */ 'R', 'e', 'f', 'r', 'e', 's', 'h', 0,          // "Refresh"
+  /* 0128 */ 'S', 't', 'o', 'p', '/', 'E', 0x95, 0,         // "Stop/E[ject]"
+  /* 0130 */ 'S', 'u', 'r', 'r', 'o', 'u', 0x96, 0,         // "Surrou[nd]"
+  /* 0138 */ 'T', 'i', 0x86, ' ', 'H', 0x8B, 'z', 0,        // "Ti[le] H[or]z"
+  /* 0140 */ 'T', 'i', 0x86, ' ', 'V', 0x94, 't', 0,        // "Ti[le] V[er]t"
+  /* 0148 */ 'T', 0x89, 'E', 'd', 'i', 't', 0x8B, 0,        // "T[ext ]Edit[or]"
+  /* 0150 */ 'Z', 'o', 0x9B, ' ', 'O', 'u', 't', 0,         // "Zo[om] Out"
+  /* 0158 */ 0x82, ' ', 'S', 'e', 0x86, 'c', 't', 0,        // "[Menu] Se[le]ct"
+  /* 0160 */ 0x92, 'e', 'v', ' ', 'L', 0x8A, 'k', 0,        // "[Pr]ev L[in]k"
+  /* 0168 */ 'A', 'u', 'd', 'i', 'o', 0x81, 0,              // "Audio[ Browser]"
+  /* 016F */ 'H', 'i', 's', 't', 0x8B, 'y', 0,              // "Hist[or]y"
+  /* 0176 */ 'L', 'o', 'g', 'o', 'f', 'f', 0,               // "Logoff"
+  /* 017D */ 'M', 'o', 'v', 'i', 'e', 0x81, 0,              // "Movie[ Browser]"
+  /* 0184 */ 'M', 0x8A, 'i', 'm', 'i', 0x97, 0,             // "M[in]imi[se]"
+  /* 018B */ 'N', 0x89, 'T', 'r', 0x8E, 'k', 0,             // "N[ext ]Tr[ac]k"
+  /* 0192 */ 'P', 'o', 'w', 0x94, ' ', 0x83, 0,             // "Pow[er] [Down]"
+  /* 0199 */ 'R', 'e', 'p', 'e', 'a', 't', 0,               // "Repeat"
+  /* 01A0 */ 'R', 'e', 'p', 'l', 0x8E, 'e', 0,              // "Repl[ac]e"
+  /* 01A7 */ 'S', 'c', 'r', 'o', 'l', 'l', 0,               // Token 88: "Scroll"
+  /* 01AE */ 'W', 'a', 'k', 'e', ' ', 0x93, 0,              // "Wake [Up]"
+  /* 01B5 */ 'Z', 'o', 0x9B, ' ', 'I', 'n', 0,              // "Zo[om] In"
+  /* 01BC */ 0x82, ' ', 'E', 'x', 'i', 't', 0,              // "[Menu] Exit"
+  /* 01C3 */ 0x82, ' ', 'H', 'e', 'l', 'p', 0,              // "[Menu] Help"
+  /* 01CA */ 0x91, '/', 'P', 'a', 'u', 0x97, 0,             // "[Play]/Pau[se]"
+  /* 01D1 */ 'A', 'p', 'p', ' ', 0x82, 0,                   // "App [Menu]"
+  /* 01D7 */ 'C', 'a', 'p', 's', 0x84, 0,                   // "Caps[Lock]"
+  /* 01DD */ 'C', 'a', 0x86, 0x96, 0x99, 0,                 // "Ca[le][nd][ar]"
+  /* 01E3 */ 'C', 'l', 'o', 'c', 'k', 0,                    // "Clock"
+  /* 01E9 */ 'C', 'o', 'l', 'd', 0x8D, 0,                   // "Cold[ Restart]"
+  /* 01EF */ 'D', 'e', 0x86, 't', 'e', 0,                   // "De[le]te"
+  /* 01F5 */ 'E', 'm', 'a', 'i', 'l', 0,                    // "Email"
+  /* 01FB */ 'F', 0x8B, 'w', 0x99, 'd', 0,                  // "F[or]w[ar]d"
+  /* 0201 */ 'G', 'o', ' ', 'T', 'o', 0,                    // "Go To"
+  /* 0207 */ 'L', 'o', 'g', 'o', 'n', 0,                    // "Logon"
+  /* 020D */ 'N', 'o', ' ', 'O', 'p', 0,                    // "No Op"
+  /* 0213 */ 'N', 0x89, 'L', 0x8A, 'k', 0,                  // "N[ext ]L[in]k"
+  /* 0219 */ 'P', 'a', 's', 't', 'e', 0,                    // "Paste"
+  /* 021F */ 'R', 'e', 'c', 0x8B, 'd', 0,                   // "Rec[or]d"
+  /* 0225 */ 'R', 'i', 'g', 'h', 't', 0,                    // Token 8C: "Right"
+  /* 022B */ 'S', 'e', 0x99, 'c', 'h', 0,                   // "Se[ar]ch"
+  /* 0231 */ 0x80, 'E', 'n', 't', 0x94, 0,                  // "[KP ]Ent[er]"
+  /* 0237 */ 0x84, 'C', 'a', 'p', 's', 0,                   // "[Lock]Caps"
+  /* 023D */ 0x92, 't', 'S', 'c', 'r', 0,                   // "[Pr]tScr"
+  /* 0243 */ 'A', 'g', 'a', 0x8A, 0,                        // "Aga[in]"
+  /* 0248 */ 'A', 'p', 'p', 'l', 0,                         // "Appl"
+  /* 024D */ 'C', 'l', 'o', 0x97, 0,                        // "Clo[se]"
+  /* 0252 */ 'C', 'o', 'n', 't', 0,                         // Token 8F: "Cont"
+  /* 0257 */ 'C', 'o', 'p', 'y', 0,                         // "Copy"
+  /* 025C */ 'D', 'o', 'w', 'n', 0,                         // Token 83: "Down"
+  /* 0261 */ 'E', 'x', 'e', 'c', 0,                         // "Exec"
+  /* 0266 */ 'F', 'i', 0x86, 0x81, 0,                       // "Fi[le][ Browser]"
+  /* 026B */ 'I', 'm', 0x85, 0x81, 0,                       // "Im[age][ Browser]"
+  /* 0270 */ 'L', 'e', 'f', 't', 0,                         // Token 90: "Left"
+  /* 0275 */ 'L', 'o', 'c', 'k', 0,                         // Token 84: "Lock"
+  /* 027A */ 'M', 'e', 'n', 'u', 0,                         // Token 82: "Menu"
+  /* 027F */ 'M', 'u', 't', 'e', 0,                         // "Mute"
+  /* 0284 */ 'N', 'u', 'm', 0x84, 0,                        // "Num[Lock]"
+  /* 0289 */ 'O', 'p', 'e', 'n', 0,                         // "Open"
+  /* 028E */ 'P', 'l', 'a', 'y', 0,                         // Token 91: "Play"
+  /* 0293 */ 'P', 'o', 'w', 0x94, 0,                        // "Pow[er]"
+  /* 0298 */ 'R', 'a', 0x96, 0x9B, 0,                       // "Ra[nd][om]"
+  /* 029D */ 'S', 'a', 'v', 'e', 0,                         // "Save"
+  /* 02A2 */ 'S', 'c', 'r', 0x84, 0,                        // "Scr[Lock]"
+  /* 02A7 */ 'S', 'l', 'o', 'w', 0,                         // "Slow"
+  /* 02AC */ 'S', 'p', 0x8E, 'e', 0,                        // "Sp[ac]e"
+  /* 02B1 */ 'S', 't', 'o', 'p', 0,                         // "Stop"
+  /* 02B6 */ 'S', 0x86, 'e', 'p', 0,                        // "S[le]ep"
+  /* 02BB */ 'V', 'o', 'l', '+', 0,                         // "Vol+"
+  /* 02C0 */ 'V', 'o', 'l', '-', 0,                         // "Vol-"
+  /* 02C5 */ 'W', 'e', 'b', 0x81, 0,                        // "Web[ Browser]"
+  /* 02CA */ 'W', 0x99, 'm', 0x8D, 0,                       // "W[ar]m[ Restart]"
+  /* 02CF */ 'e', 'x', 't', ' ', 0,                         // Token 89: "ext "
+  /* 02D4 */ 'j', 'e', 'c', 't', 0,                         // Token 95: "ject"
+  /* 02D9 */ 0x80, 'D', 'e', 'l', 0,                        // "[KP ]Del"
+  /* 02DE */ 0x80, 'H', 0x9B, 'e', 0,                       // "[KP ]H[om]e"
+  /* 02E3 */ 0x80, 'I', 'n', 's', 0,                        // "[KP ]Ins"
+  /* 02E8 */ 0x80, 'P', 0x85, 0x83, 0,                      // "[KP ]P[age][Down]"
+  /* 02ED */ 0x80, 'P', 0x85, 0x93, 0,                      // "[KP ]P[age][Up]"
+  /* 02F2 */ 0x84, 'N', 'u', 'm', 0,                        // "[Lock]Num"
+  /* 02F7 */ 0x8F, 0x8E, 't', 's', 0,                       // "[Cont][ac]ts"
+  /* 02FC */ 'B', 0x8E, 'k', 0,                             // "B[ac]k"
+  /* 0300 */ 'C', 'h', '+', 0,                              // "Ch+"
+  /* 0304 */ 'C', 'h', '-', 0,                              // "Ch-"
+  /* 0308 */ 'C', 'u', 't', 0,                              // "Cut"
+  /* 030C */ 'C', 0x86, 0x99, 0,                            // "C[le][ar]"
+  /* 0310 */ 'E', 's', 'c', 0,                              // "Esc"
+  /* 0314 */ 'F', 0x8A, 'd', 0,                             // "F[in]d"
+  /* 0318 */ 'K', 'P', ' ', 0,                              // Token 80: "KP "
+  /* 031C */ 'M', 'P', 'X', 0,                              // "MPX"
+  /* 0320 */ 'N', 0x9A, 's', 0,                             // "N[ew]s"
+  /* 0324 */ 'T', 'a', 'b', 0,                              // "Tab"
+  /* 0328 */ 'U', 0x96, 'o', 0,                             // "U[nd]o"
+  /* 032C */ 'a', 'g', 'e', 0,                              // Token 85: "age"
+  /* 0330 */ 0x80, 'E', 0x96, 0,                            // "[KP ]E[nd]"
+  /* 0334 */ 0x82, ' ', 0x83, 0,                            // "[Menu] [Down]"
+  /* 0338 */ 0x82, ' ', 0x8C, 0,                            // "[Menu] [Right]"
+  /* 033C */ 0x82, ' ', 0x90, 0,                            // "[Menu] [Left]"
+  /* 0340 */ 0x82, ' ', 0x93, 0,                            // "[Menu] [Up]"
+  /* 0344 */ 0x88, ' ', 0x83, 0,                            // "[Scroll] [Down]"
+  /* 0348 */ 0x88, ' ', 0x93, 0,                            // "[Scroll] [Up]"
+  /* 034C */ 0x8F, 0x89, 0x82, 0,                           // "[Cont][ext ][Menu]"
+  /* 0350 */ 0x92, 0x8A, 't', 0,                            // "[Pr][in]t"
+  /* 0354 */ 'F', '1', 0,                                   // Token 87: "F1"
+  /* 0357 */ 'F', '2', 0,                                   // Token 98: "F2"
+  /* 035A */ 'F', '3', 0,                                   // "F3"
+  /* 035D */ 'F', '4', 0,                                   // "F4"
+  /* 0360 */ 'F', '5', 0,                                   // "F5"
+  /* 0363 */ 'F', '6', 0,                                   // "F6"
+  /* 0366 */ 'F', '7', 0,                                   // "F7"
+  /* 0369 */ 'F', '8', 0,                                   // "F8"
+  /* 036C */ 'F', '9', 0,                                   // "F9"
+  /* 036F */ 'F', 'F', 0,                                   // "FF"
+  /* 0372 */ 'N', 0x9A, 0,                                  // "N[ew]"
+  /* 0375 */ 'P', 'r', 0,                                   // Token 92: "Pr"
+  /* 0378 */ 'R', 0x9A, 0,                                  // "R[ew]"
+  /* 037B */ 'U', 'p', 0,                                   // Token 93: "Up"
+  /* 037E */ 'a', 'c', 0,                                   // Token 8E: "ac"
+  /* 0381 */ 'a', 'r', 0,                                   // Token 99: "ar"
+  /* 0384 */ 'e', 'w', 0,                                   // Token 9A: "ew"
+  /* 0387 */ 'i', 'n', 0,                                   // Token 8A: "in"
+  /* 038A */ 'l', 'e', 0,                                   // Token 86: "le"
+  /* 038D */ 'n', 'd', 0,                                   // Token 96: "nd"
+  /* 0390 */ 'o', 'm', 0,                                   // Token 9B: "om"
+  /* 0393 */ 'o', 'r', 0,                                   // Token 8B: "or"
+  /* 0396 */ 's', 'e', 0,                                   // Token 97: "se"
+  /* 0399 */ 0x80, '*', 0,                                  // "[KP ]*"
+  /* 039C */ 0x80, '+', 0,                                  // "[KP ]+"
+  /* 039F */ 0x80, ',', 0,                                  // "[KP ],"
+  /* 03A2 */ 0x80, '-', 0,                                  // "[KP ]-"
+  /* 03A5 */ 0x80, '.', 0,                                  // "[KP ]."
+  /* 03A8 */ 0x80, '/', 0,                                  // "[KP ]/"
+  /* 03AB */ 0x80, '0', 0,                                  // "[KP ]0"
+  /* 03AE */ 0x80, '1', 0,                                  // "[KP ]1"
+  /* 03B1 */ 0x80, '2', 0,                                  // "[KP ]2"
+  /* 03B4 */ 0x80, '3', 0,                                  // "[KP ]3"
+  /* 03B7 */ 0x80, '4', 0,                                  // "[KP ]4"
+  /* 03BA */ 0x80, '5', 0,                                  // "[KP ]5"
+  /* 03BD */ 0x80, '6', 0,                                  // "[KP ]6"
+  /* 03C0 */ 0x80, '7', 0,                                  // "[KP ]7"
+  /* 03C3 */ 0x80, '8', 0,                                  // "[KP ]8"
+  /* 03C6 */ 0x80, '9', 0,                                  // "[KP ]9"
+  /* 03C9 */ 0x80, '=', 0,                                  // "[KP ]="
+  /* 03CC */ 0x80, 0x83, 0,                                 // "[KP ][Down]"
+  /* 03CF */ 0x80, 0x8C, 0,                                 // "[KP ][Right]"
+  /* 03D2 */ 0x80, 0x90, 0,                                 // "[KP ][Left]"
+  /* 03D5 */ 0x80, 0x93, 0,                                 // "[KP ][Up]"
+  /* 03D8 */ 0x84, 0x88, 0,                                 // "[Lock][Scroll]"
+  /* 03DB */ 0x87, '0', 0,                                  // "[F1]0"
+  /* 03DE */ 0x87, '1', 0,                                  // "[F1]1"
+  /* 03E1 */ 0x87, '2', 0,                                  // "[F1]2"
+  /* 03E4 */ 0x87, '3', 0,                                  // "[F1]3"
+  /* 03E7 */ 0x87, '4', 0,                                  // "[F1]4"
+  /* 03EA */ 0x87, '5', 0,                                  // "[F1]5"
+  /* 03ED */ 0x87, '6', 0,                                  // "[F1]6"
+  /* 03F0 */ 0x87, '7', 0,                                  // "[F1]7"
+  /* 03F3 */ 0x87, '8', 0,                                  // "[F1]8"
+  /* 03F6 */ 0x87, '9', 0,                                  // "[F1]9"
+  /* 03F9 */ 0x98, '0', 0,                                  // "[F2]0"
+  /* 03FC */ 0x98, '1', 0,                                  // "[F2]1"
+  /* 03FF */ 0x98, '2', 0,                                  // "[F2]2"
+  /* 0402 */ 0x98, '3', 0,                                  // "[F2]3"
+  /* 0405 */ 0x98, '4', 0,                                  // "[F2]4"
+  /* 0408 */ '!', 0,                                        // "!"
+  /* 040A */ '"', 0,                                        // """
+  /* 040C */ '#', 0,                                        // "#"
+  /* 040E */ '$', 0,                                        // "$"
+  /* 0410 */ '%', 0,                                        // "%"
+  /* 0412 */ '&', 0,                                        // "&"
+  /* 0414 */ '\'', 0,                                       // "'"
+  /* 0416 */ '(', 0,                                        // "("
+  /* 0418 */ ')', 0,                                        // ")"
+  /* 041A */ ':', 0,                                        // ":"
+  /* 041C */ ';', 0,                                        // ";"
+  /* 041E */ '<', 0,                                        // "<"
+  /* 0420 */ '>', 0,                                        // ">"
+  /* 0422 */ '?', 0,                                        // "?"
+  /* 0424 */ '@', 0,                                        // "@"
+  /* 0426 */ 'A', 0,                                        // "A"
+  /* 0428 */ 'B', 0,                                        // "B"
+  /* 042A */ 'C', 0,                                        // "C"
+  /* 042C */ 'D', 0,                                        // "D"
+  /* 042E */ 'E', 0,                                        // "E"
+  /* 0430 */ 'G', 0,                                        // "G"
+  /* 0432 */ 'H', 0,                                        // "H"
+  /* 0434 */ 'I', 0,                                        // "I"
+  /* 0436 */ 'J', 0,                                        // "J"
+  /* 0438 */ 'K', 0,                                        // "K"
+  /* 043A */ 'L', 0,                                        // "L"
+  /* 043C */ 'M', 0,                                        // "M"
+  /* 043E */ 'N', 0,                                        // "N"
+  /* 0440 */ 'O', 0,                                        // "O"
+  /* 0442 */ 'P', 0,                                        // "P"
+  /* 0444 */ 'Q', 0,                                        // "Q"
+  /* 0446 */ 'R', 0,                                        // "R"
+  /* 0448 */ 'S', 0,                                        // "S"
+  /* 044A */ 'T', 0,                                        // "T"
+  /* 044C */ 'U', 0,                                        // "U"
+  /* 044E */ 'V', 0,                                        // "V"
+  /* 0450 */ 'W', 0,                                        // "W"
+  /* 0452 */ 'Y', 0,                                        // "Y"
+  /* 0454 */ 'Z', 0,                                        // "Z"
+  /* 0456 */ '[', 0,                                        // "["
+  /* 0458 */ '\\', 0,                                       // "\"
+  /* 045A */ ']', 0,                                        // "]"
+  /* 045C */ '^', 0,                                        // "^"
+  /* 045E */ '_', 0,                                        // "_"
+  /* 0460 */ '`', 0,                                        // "`"
+  /* 0462 */ 'a', 0,                                        // "a"
+  /* 0464 */ 'i', 0,                                        // "i"
+  /* 0466 */ 'j', 0,                                        // "j"
+  /* 0468 */ 'q', 0,                                        // "q"
+  /* 046A */ 'v', 0,                                        // "v"
+  /* 046C */ 'x', 0,                                        // "x"
+  /* 046E */ '{', 0,                                        // "{"
+  /* 0470 */ '|', 0,                                        // "|"
+  /* 0472 */ '}', 0,                                        // "}"
+  /* 0474 */ '~', 0,                                        // "~"
+  /* 0476 */ 0x87, 0,                                       // "[F1]"
+  /* 0478 */ 0x91, 0,                                       // "[Play]"
+  /* 047A */ 0x98, 0,                                       // "[F2]"
+};
+
+const uint16_t USAGE_TOKEN[] =
+{
+  /* 00 */ 0x0318, 0x00A6, 0x027A, 0x025C, 0x0275, 0x032C, 0x038A, 0x0354,
+  /* 08 */ 0x01A7, 0x02CF, 0x0387, 0x0393, 0x0225, 0x00AF, 0x037E, 0x0252,
+  /* 10 */ 0x0270, 0x028E, 0x0375, 0x037B, 0x00AC, 0x02D4, 0x038D, 0x0396,
+  /* 18 */ 0x0357, 0x0381, 0x0384, 0x0390,
+};
+
+const uint16_t UNSHIFTED_USB_TEXT[] =
+{
+  /* 00 */ 0x020D, 0x0000, 0x0000, 0x0000, 0x0462, 0x0326, 0x0264, 0x01FF,
+  /* 08 */ 0x0072, 0x017B, 0x00DA, 0x0126, 0x0464, 0x0466, 0x00FE, 0x0053,
+  /* 10 */ 0x02F5, 0x001A, 0x0205, 0x0116, 0x0468, 0x0048, 0x00C8, 0x0026,
+  /* 18 */ 0x027D, 0x046A, 0x00E3, 0x046C, 0x00EC, 0x013E, 0x0355, 0x0358,
+  /* 20 */ 0x035B, 0x035E, 0x0361, 0x0364, 0x0367, 0x036A, 0x036D, 0x03AC,
+  /* 28 */ 0x0232, 0x0310, 0x0100, 0x0324, 0x02AC, 0x02C3, 0x03CA, 0x0456,
+  /* 30 */ 0x045A, 0x0458, 0x040C, 0x041C, 0x0414, 0x0460, 0x03A0, 0x03A6,
+  /* 38 */ 0x03A9, 0x01D7, 0x0476, 0x047A, 0x035A, 0x035D, 0x0360, 0x0363,
+  /* 40 */ 0x0366, 0x0369, 0x036C, 0x03DB, 0x03DE, 0x03E1, 0x023D, 0x02A2,
+  /* 48 */ 0x01CC, 0x02E4, 0x02DF, 0x02EE, 0x01EF, 0x0331, 0x02E9, 0x033A,
+  /* 50 */ 0x033E, 0x0197, 0x01B3, 0x0284, 0x03A8, 0x0399, 0x03A2, 0x039C,
+  /* 58 */ 0x0231, 0x03AE, 0x03B1, 0x03B4, 0x03B7, 0x03BA, 0x03BD, 0x03C0,
+  /* 60 */ 0x03C3, 0x03C6, 0x03AB, 0x03A5, 0x0458, 0x0248, 0x0293, 0x03C9,
+  /* 68 */ 0x03E4, 0x03E7, 0x03EA, 0x03ED, 0x03F0, 0x03F3, 0x03F6, 0x03F9,
+  /* 70 */ 0x03FC, 0x03FF, 0x0402, 0x0405, 0x0261, 0x01C5, 0x01D5, 0x015A,
+  /* 78 */ 0x02B1, 0x0243, 0x0328, 0x0308, 0x0257, 0x0219, 0x0314, 0x027F,
+  /* 80 */ 0x02BB, 0x02C0, 0x0237, 0x02F2, 0x03D8, 0x039F, 0x03C9,
+};
+
+const uint16_t SHIFTED_USB_TEXT[] =
+{
+  /* 00 */ 0x0000, 0x0000, 0x0000, 0x0000, 0x0426, 0x0428, 0x042A, 0x042C,
+  /* 08 */ 0x042E, 0x0370, 0x0430, 0x0432, 0x0434, 0x0436, 0x0438, 0x043A,
+  /* 10 */ 0x043C, 0x043E, 0x0440, 0x0442, 0x0444, 0x0446, 0x0448, 0x044A,
+  /* 18 */ 0x044C, 0x044E, 0x0450, 0x031E, 0x0452, 0x0454, 0x0408, 0x0424,
+  /* 20 */ 0x040C, 0x040E, 0x0410, 0x045C, 0x0412, 0x039A, 0x0416, 0x0418,
+  /* 28 */ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x045E, 0x02BE, 0x046E,
+  /* 30 */ 0x0472, 0x0470, 0x0474, 0x041A, 0x040A, 0x0474, 0x041E, 0x0420,
+  /* 38 */ 0x0422, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  /* 40 */ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  /* 48 */ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  /* 50 */ 0x0000, 0x0000, 0x0000, 0x030C, 0x0000, 0x0000, 0x0000, 0x0000,
+  /* 58 */ 0x0000, 0x0330, 0x03CC, 0x02E8, 0x03D2, 0x0000, 0x03CF, 0x02DE,
+  /* 60 */ 0x03D5, 0x02ED, 0x02E3, 0x02D9, 0x0470,
+};
+
+const uint16_t SYSTEM_CONTROL_USAGE[] =
+{
+  /* 00 */ 0x001, 0x002, 0x003, 0x004, 0x005, 0x006, 0x007, 0x008,
+  /* 08 */ 0x009, 0x00A, 0x00B, 0x00C, 0x00D, 0x00E,
+};
+
+const uint16_t SYSTEM_CONTROL_TEXT[] =
+{
+  /* 00 */ 0x0192, 0x02B6, 0x01AE, 0x034C, 0x01D1, 0x01C3, 0x01BC, 0x0158,
+  /* 08 */ 0x0338, 0x033C, 0x0340, 0x0334, 0x01E9, 0x02CA,
+};
+
+const uint16_t CONSUMER_DEVICE_USAGE[] =
+{
+  /* 00 */ 0x09D, 0x09E, 0x0B0, 0x0B1, 0x0B2, 0x0B3, 0x0B4, 0x0B5,
+  /* 08 */ 0x0B6, 0x0B7, 0x0B8, 0x0B9, 0x0BC, 0x0CC, 0x0CD, 0x0E2,
+  /* 10 */ 0x0E5, 0x0E6, 0x0E7, 0x0E8, 0x0E9, 0x0EA, 0x0F5, 0x184,
+  /* 18 */ 0x185, 0x186, 0x187, 0x188, 0x189, 0x18A, 0x18B, 0x18C,
+  /* 20 */ 0x18D, 0x18E, 0x18F, 0x192, 0x196, 0x19A, 0x19B, 0x19C,
+  /* 28 */ 0x19E, 0x19F, 0x1A0, 0x1A1, 0x1AA, 0x1B3, 0x1B4, 0x1B6,
+  /* 30 */ 0x1B7, 0x1B8, 0x1BB, 0x1C6, 0x201, 0x202, 0x203, 0x204,
+  /* 38 */ 0x205, 0x206, 0x207, 0x208, 0x21A, 0x21B, 0x21C, 0x21D,
+  /* 40 */ 0x21E, 0x21F, 0x220, 0x221, 0x222, 0x223, 0x224, 0x225,
+  /* 48 */ 0x226, 0x227, 0x228, 0x229, 0x22A, 0x22B, 0x22D, 0x22E,
+  /* 50 */ 0x230, 0x231, 0x232, 0x233, 0x234, 0x239, 0x23A, 0x23B,
+};
+
+const uint16_t CONSUMER_DEVICE_TEXT[] =
+{
+  /* 00 */ 0x0300, 0x0304, 0x0478, 0x01CC, 0x021F, 0x036F, 0x0378, 0x018B,
+  /* 08 */ 0x00F7, 0x02B1, 0x012D, 0x0298, 0x0199, 0x0128, 0x01CA, 0x027F,
+  /* 10 */ 0x0034, 0x0130, 0x00CA, 0x031C, 0x02BB, 0x02C0, 0x02A7, 0x0028,
+  /* 18 */ 0x0148, 0x001C, 0x0001, 0x0055, 0x0108, 0x01F5, 0x0320, 0x0092,
+  /* 20 */ 0x02F7, 0x01DD, 0x009C, 0x0060, 0x02C5, 0x00E5, 0x0207, 0x0176,
+  /* 28 */ 0x00EE, 0x004A, 0x006A, 0x003F, 0x0110, 0x01E3, 0x0266, 0x026B,
+  /* 30 */ 0x0168, 0x017D, 0x00D3, 0x00B8, 0x0372, 0x0289, 0x024D, 0x01BE,
+  /* 38 */ 0x0118, 0x0184, 0x029D, 0x0350, 0x0328, 0x0257, 0x0308, 0x0219,
+  /* 40 */ 0x007E, 0x0314, 0x01A0, 0x022B, 0x0201, 0x02DF, 0x02FC, 0x01FB,
+  /* 48 */ 0x02B1, 0x0120, 0x0160, 0x0213, 0x00C1, 0x016F, 0x01B5, 0x0150,
+  /* 50 */ 0x0010, 0x0074, 0x0088, 0x0348, 0x0344, 0x00DC, 0x0138, 0x0140,
+};
+
@@ -0,0 +1,262 @@
+/*
+  PUB! Programmable USB Button - The firmware built for the host
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// The firmware is included whole (pub.h defines its variables, so it is
+// one translation unit), and this file supplies what mikroC and the PIC
+// would: the registers and library routines declared in hal.h.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pub.c"                    // As converted by mikroc.sed
+#include "device.h"
+
+t_deviceCounts deviceCounts;
+uint8_t deviceEEPROM[256];
+void (*pDeviceReportHandler)(const uint8_t * pReport, uint8_t len);
+long nDevicePollMs = 1;
+
+uint8_t * pProgramReply;            // Where deviceProgramCommand() wants the reply
+
+long nNow;                          // Milliseconds since power up
+long nNextPoll;                     // When the host next polls for a report
+
+
+/* ------------------------------------------------------------------------ */
+/* The PIC                                                                  */
+/* ------------------------------------------------------------------------ */
+
+volatile uint8_t ANSELA, ANSELB, ANSELC, LATA, LATB, LATC, TRISA, TRISB, TRISC;
+volatile uint8_t OSCCON, OSCCON2, T0CON, T1CON, T3CON, TMR3H, TMR3L;
+
+volatile uint8_t RB4_bit, RB5_bit, LATA0_bit, NOT_RBPU_bit;
+volatile uint8_t RB6_bit = 1;       // The knob is not pressed
+volatile uint8_t HFIOFS_bit = 1, OSTS_bit = 1, PLLRDY_bit = 1; // The clock is always ready
+volatile uint8_t PLLEN_bit, SPLLMULT_bit;
+volatile uint8_t ACTEN_bit, ACTSRC_bit, UPUEN_bit, FSEN_bit;
+volatile uint8_t IOCIF_bit, IOCIE_bit, IOCB4_bit, IOCB5_bit, IOCB6_bit;
+volatile uint8_t TMR0IE_bit, TMR0IF_bit, TMR3IE_bit, TMR3IF_bit, PEIE_bit, GIE_bit;
+volatile uint8_t TMR3ON_bit = 1;    // Prolog() turns Timer3 on (through T3CON)
+volatile uint8_t IDLEN_bit, IDLEIF_bit, ACTVIE_bit, ACTVIF_bit, SUSPND_bit;
+
+void tick()
+{
+  // One millisecond passes, which is one Timer3 tick if it is on. Timer0
+  // overflows about every 44 ms (22.9 times a second)
+  nNow++;
+  deviceCounts.nMs++;
+  if (TMR3ON_bit)
+    TMR3IF_bit = 1;
+  if (nNow % 44 == 0)
+    TMR0IF_bit = 1;
+  if (GIE_bit && ((TMR0IE_bit && TMR0IF_bit) || (TMR3IE_bit && TMR3IF_bit)))
+    deviceInterrupt();
+}
+
+void hostSleep()
+{
+  tick();                           // The next interrupt is the millisecond tick
+}
+
+void Delay_ms(uint16_t n)
+{
+  while (n--)
+    tick();
+}
+
+void Delay_us(uint16_t n)
+{
+}
+
+uint8_t EEPROM_Read(uint16_t addr)
+{
+  return deviceEEPROM[addr & 0xFF];
+}
+
+void EEPROM_Write(uint16_t addr, uint8_t b)
+{
+  deviceEEPROM[addr & 0xFF] = b;
+  deviceCounts.nEEPROMWrites++;
+}
+
+void ByteToStr(uint8_t n, char * s)
+{
+  sprintf(s, "%3u", n);
+}
+
+void ShortToStr(int8_t n, char * s)
+{
+  sprintf(s, "%4d", n);
+}
+
+void WordToStr(uint16_t n, char * s)
+{
+  sprintf(s, "%5u", n);
+}
+
+
+/* ------------------------------------------------------------------------ */
+/* The USB host                                                             */
+/* ------------------------------------------------------------------------ */
+
+void HID_Enable(void * pFromHost, void * pToHost)
+{
+}
+
+void HID_Disable()
+{
+}
+
+uint8_t HID_Read()
+{
+  return 0;                         // The host never sends anything unasked
+}
+
+uint8_t HID_Write(void * p, uint8_t len)
+{
+  // The endpoint holds each report until the host polls for it (every
+  // nDevicePollMs), so the next one waits until then
+  while (nNow < nNextPoll)
+    tick();
+  nNextPoll = nNow + nDevicePollMs;
+  deviceCounts.nReports++;
+  if (pDeviceReportHandler)
+    pDeviceReportHandler(p, len);
+  return len;
+}
+
+void USB_Interrupt_Proc()
+{
+}
+
+
+/* ------------------------------------------------------------------------ */
+/* The device                                                               */
+/* ------------------------------------------------------------------------ */
+
+void deviceStart(const char * sFile)
+{
+  memset(deviceEEPROM, 0xFF, sizeof(deviceEEPROM));
+#if STORAGE == STORAGE_FILE
+  sStorageFile = sFile;
+#endif
+  Prolog();
+  deviceResetCounts();
+}
+
+void deviceResetCounts()
+{
+  memset(&deviceCounts, 0, sizeof(deviceCounts));
+}
+
+void deviceSetActions(const uint16_t * pActions, uint8_t n)
+{
+  uint8_t i;
+  if (n > ELEMENTS(aAction))
+    n = ELEMENTS(aAction);
+  for (i = 0; i < ELEMENTS(aAction); i++)
+    aAction[i].action = i < n ? pActions[i] : 0;
+  nAction = n;
+  nActionFocus = n;
+  setAllBits(aDirty, TRUE);         // None of them are saved
+}
+
+void devicePlay()
+{
+  bProgramMode = FALSE;
+  play();
+  waitForReports();
+}
+
+void deviceRedisplay()
+{
+  bProgramMode = TRUE;
+  displayProgrammingMenu();
+  waitForReports();
+}
+
+void deviceStoreAction(uint8_t n, uint16_t code)
+{
+  // As pressing the knob does once the action has been chosen
+  nActionFocus = n;
+  action.action = code;
+  storeAction();
+  selectLine(SELECTION_LINE);
+  sayUsage(nActionFocus, &action);
+  selectLine(SELECTION_LINE);
+  waitForReports();
+}
+
+void deviceDeleteAction(uint8_t n)
+{
+  deleteAction(n);
+  waitForReports();
+}
+
+uint16_t deviceCalibrate()
+{
+  // As the "Calibrate report rate" Do function does
+  calibrateReportRate();
+  return nReportMs;
+}
+
+void deviceTurn(int8_t nSteps)
+{
+  // As programMode() does when the knob is turned nSteps in one go
+  rotation = nSteps;
+  distance = nSteps;
+  programMode();
+  waitForReports();
+}
+
+void deviceChoosePage()
+{
+  // As a short press does in PROGRAM mode with the focus on the page
+  changePage();
+  waitForReports();
+}
+
+uint8_t deviceSave(uint8_t n)
+{
+  return saveProgram(n);
+}
+
+void takeProgramReply(const uint8_t * pReport, uint8_t len)
+{
+  // Any other report is not for the host program, so it is dropped
+  if (pReport[0] == REPORT_ID_PROGRAM)
+    memcpy(pProgramReply, pReport, len);
+}
+
+void deviceProgramCommand(const uint8_t * pRequest, uint8_t * pReply)
+{
+  // As main() does when the host sends a program report
+  void (*pHandler)(const uint8_t * pReport, uint8_t len);
+
+  pHandler = pDeviceReportHandler;
+  pDeviceReportHandler = takeProgramReply;
+  pProgramReply = pReply;
+  doProgramCommand((t_programReport *)(pRequest + 1));
+  waitForReports();
+  pDeviceReportHandler = pHandler;
+}
@@ -0,0 +1,66 @@
+/*
+  PUB! Programmable USB Button - The firmware built for the host
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// A PUB! device simulated on the host: src/pub.c itself, built against
+// the stand-ins in hal.h (see tools/Makefile), so that tools can measure
+// and exercise it with no device attached.
+//
+// Time passes only in simulated milliseconds: while the firmware sleeps,
+// delays, or waits for the host to poll for a report. The timer interrupts
+// run as they would on the device.
+
+#include <stdint.h>
+
+typedef struct
+{
+  long nReports;                    // Reports the device sent to the host
+  long nMs;                         // Milliseconds that passed
+  long nEEPROMWrites;               // Bytes written to the on-chip EEPROM
+} t_deviceCounts;
+
+extern t_deviceCounts deviceCounts;
+
+extern uint8_t deviceEEPROM[256];   // The on-chip EEPROM (erased at first)
+
+extern long nDevicePollMs;          // How often the host polls for a report (1 at first)
+
+// Called with each report the device sends (the report id first), if set
+extern void (*pDeviceReportHandler)(const uint8_t * pReport, uint8_t len);
+
+void deviceStart(const char * sFile);  // Power up (the file is for a STORAGE_FILE build)
+void deviceResetCounts(void);
+
+void deviceSetActions(const uint16_t * pActions, uint8_t n);  // Replace the actions in RAM
+void devicePlay(void);              // Play the actions, as a click in RUN mode does
+void deviceRedisplay(void);         // Type the PROGRAM mode display afresh
+uint16_t deviceCalibrate(void);     // Measure the host's report rate (ms per report)
+void deviceStoreAction(uint8_t n, uint16_t code);  // Set (or append) action n in PROGRAM mode
+void deviceDeleteAction(uint8_t n); // "Delete action" n in PROGRAM mode
+void deviceTurn(int8_t nSteps);     // Turn the knob in PROGRAM mode (+ is clockwise)
+void deviceChoosePage(void);        // Press the knob with the focus on the page
+uint8_t deviceSave(uint8_t n);      // "Save as program" n (0 if it is too big to save)
+
+// A program report from the host (see "Program Output Report" in
+// src/USBdsc.c), and the one the device replies with. Both start with
+// the report id, and are 1+sizeof(t_programReport) bytes long
+void deviceProgramCommand(const uint8_t * pRequest, uint8_t * pReply);
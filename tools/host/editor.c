@@ -0,0 +1,305 @@
+/*
+  PUB! Programmable USB Button - A text editor driven by keyboard reports
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+#include <string.h>
+
+#include "editor.h"
+
+#define MAX_LINES       512
+#define MAX_COLUMNS     255
+#define MAX_KEYS        6           // Keys in a keyboard report
+
+#define SHIFT           0x11        // Left or right (the bits are in the order
+#define CTL             0x22        // of the Keyboard Input Report descriptor)
+
+#define KEY_ENTER       0x28
+#define KEY_BACKSPACE   0x2A
+#define KEY_HOME        0x4A
+#define KEY_DELETE      0x4C
+#define KEY_END         0x4D
+#define KEY_RIGHT       0x4F
+#define KEY_LEFT        0x50
+#define KEY_DOWN        0x51
+#define KEY_UP          0x52
+
+#define FIRST_CHAR_KEY  0x04        // The keys US_KEYS gives the characters of
+#define LAST_CHAR_KEY   0x38
+
+static const char * const US_KEYS[2] = // Unshifted and shifted (0 for no character)
+{
+  "abcdefghijklmnopqrstuvwxyz1234567890\0\0\0\0 -=[]\\#;'`,./",
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZ!@#$%^&*()\0\0\0\0 _+{}|~:\"~<>?",
+};
+
+typedef struct
+{
+  int line;
+  int column;
+} t_place;
+
+static char aLine[MAX_LINES][MAX_COLUMNS+1];
+static int nLines;
+static t_place caret;
+static t_place anchor;              // The other end of the selection, if any
+static int bSelection;
+static int nColumnWanted;           // Where UP and DOWN try to keep the caret
+static uint8_t aKeysDown[MAX_KEYS]; // The keys in the last keyboard report
+static int nKeysDown;
+static int nUnknownKeys;
+static int bReverseKeys;            // Whether new keys are taken last to first
+static char sText[MAX_LINES * (MAX_COLUMNS+1) + 1];
+
+
+static int getLength(int line)
+{
+  return strlen(aLine[line]);
+}
+
+static int isBefore(t_place a, t_place b)
+{
+  return a.line < b.line || (a.line == b.line && a.column < b.column);
+}
+
+static void deleteSelection()
+{
+  t_place from;
+  t_place to;
+  int nJoined;
+  bSelection = 0;
+  from = isBefore(anchor, caret) ? anchor : caret;
+  to = isBefore(anchor, caret) ? caret : anchor;
+  nJoined = getLength(to.line) - to.column;  // What is left of the last line
+  if (from.column + nJoined > MAX_COLUMNS)
+    nJoined = MAX_COLUMNS - from.column;
+  memmove(aLine[from.line] + from.column, aLine[to.line] + to.column, nJoined);
+  aLine[from.line][from.column + nJoined] = '\0';
+  memmove(aLine[from.line+1], aLine[to.line+1], (nLines - to.line - 1) * sizeof(aLine[0]));
+  nLines -= to.line - from.line;
+  caret = from;
+}
+
+static void moveTo(int line, int column, int bSelecting)
+{
+  // Moves the caret, and either extends the selection or drops it
+  if (!bSelecting)
+    bSelection = 0;
+  else if (!bSelection)
+  {
+    bSelection = 1;
+    anchor = caret;
+  }
+  caret.line = line;
+  caret.column = column;
+}
+
+static void moveToRow(int line, int bSelecting)
+{
+  // UP and DOWN: the caret goes to the end of the text beyond either end
+  if (line < 0)
+    moveTo(0, 0, bSelecting);
+  else if (line >= nLines)
+    moveTo(nLines - 1, getLength(nLines - 1), bSelecting);
+  else
+    moveTo(line, nColumnWanted < getLength(line) ? nColumnWanted : getLength(line), bSelecting);
+}
+
+static void insertChar(char c)
+{
+  char * p;
+  if (bSelection)
+    deleteSelection();
+  p = aLine[caret.line];
+  if (getLength(caret.line) == MAX_COLUMNS)
+    return;
+  memmove(p + caret.column + 1, p + caret.column, getLength(caret.line) - caret.column + 1);
+  p[caret.column++] = c;
+}
+
+static void splitLine()
+{
+  if (bSelection)
+    deleteSelection();
+  if (nLines == MAX_LINES)
+    return;
+  memmove(aLine[caret.line+2], aLine[caret.line+1], (nLines - caret.line - 1) * sizeof(aLine[0]));
+  nLines++;
+  memmove(aLine[caret.line+1], aLine[caret.line] + caret.column, getLength(caret.line) - caret.column + 1);
+  aLine[caret.line][caret.column] = '\0';
+  caret.line++;
+  caret.column = 0;
+}
+
+static void deleteChar(int bBackwards)
+{
+  // DELETE removes the character after the caret, BACKSPACE the one before,
+  // and either joins the lines at the end of a line
+  if (bSelection)
+  {
+    deleteSelection();
+    return;
+  }
+  anchor = caret;
+  if (bBackwards)
+  {
+    if (caret.column)
+      anchor.column--;
+    else if (caret.line)
+      anchor.line--, anchor.column = getLength(anchor.line);
+  }
+  else
+  {
+    if (caret.column < getLength(caret.line))
+      anchor.column++;
+    else if (caret.line + 1 < nLines)
+      anchor.line++, anchor.column = 0;
+  }
+  deleteSelection();
+}
+
+static void pressKey(uint8_t modifiers, uint8_t key)
+{
+  int bSelecting = (modifiers & SHIFT) != 0;
+  int bCtl = (modifiers & CTL) != 0;
+  char c;
+
+  switch (key)
+  {
+    case KEY_HOME:
+      moveTo(bCtl ? 0 : caret.line, 0, bSelecting);
+      break;
+    case KEY_END:
+      if (bCtl)
+        moveTo(nLines - 1, getLength(nLines - 1), bSelecting);
+      else
+        moveTo(caret.line, getLength(caret.line), bSelecting);
+      break;
+    case KEY_UP:
+    case KEY_DOWN:
+      moveToRow(caret.line + (key == KEY_DOWN ? 1 : -1), bSelecting);
+      return;                       // Keep the column wanted
+    case KEY_RIGHT:
+      if (caret.column < getLength(caret.line))
+        moveTo(caret.line, caret.column + 1, bSelecting);
+      else if (caret.line + 1 < nLines)
+        moveTo(caret.line + 1, 0, bSelecting);
+      break;
+    case KEY_LEFT:
+      if (caret.column)
+        moveTo(caret.line, caret.column - 1, bSelecting);
+      else if (caret.line)
+        moveTo(caret.line - 1, getLength(caret.line - 1), bSelecting);
+      break;
+    case KEY_DELETE:
+    case KEY_BACKSPACE:
+      deleteChar(key == KEY_BACKSPACE);
+      break;
+    case KEY_ENTER:
+      splitLine();
+      break;
+    default:
+      c = 0;
+      if (key >= FIRST_CHAR_KEY && key <= LAST_CHAR_KEY && !bCtl)
+        c = US_KEYS[bSelecting][key - FIRST_CHAR_KEY];
+      if (c)
+        insertChar(c);
+      else
+        nUnknownKeys++;
+      break;
+  }
+  nColumnWanted = caret.column;
+}
+
+void editorClear()
+{
+  nLines = 1;
+  aLine[0][0] = '\0';
+  caret.line = 0;
+  caret.column = 0;
+  bSelection = 0;
+  nColumnWanted = 0;
+  nKeysDown = 0;
+  nUnknownKeys = 0;
+}
+
+void editorSetReversed(int bReversed)
+{
+  bReverseKeys = bReversed;
+}
+
+void editorReport(const uint8_t * pReport, uint8_t len)
+{
+  // A key is pressed when a report first includes it. The keys that one
+  // report presses are taken in the order they appear, or in reverse
+  uint8_t aKeys[MAX_KEYS];
+  uint8_t aNewKeys[MAX_KEYS];
+  int nKeys;
+  int nNewKeys;
+  int i;
+  int j;
+
+  if (pReport[0] != 'K')            // Only keyboard reports change the text
+    return;
+  if (!nLines)
+    editorClear();
+  nKeys = 0;
+  nNewKeys = 0;
+  for (i = 3; i < len && nKeys < MAX_KEYS; i++)
+  {
+    if (!pReport[i])
+      continue;
+    aKeys[nKeys++] = pReport[i];
+    for (j = 0; j < nKeysDown && aKeysDown[j] != pReport[i]; j++);
+    if (j == nKeysDown)             // If it was not already down
+      aNewKeys[nNewKeys++] = pReport[i];
+  }
+  for (i = 0; i < nNewKeys; i++)
+    pressKey(pReport[1], aNewKeys[bReverseKeys ? nNewKeys - 1 - i : i]);
+  memcpy(aKeysDown, aKeys, nKeys);
+  nKeysDown = nKeys;
+}
+
+const char * editorText()
+{
+  char * p = sText;
+  int i;
+  if (!nLines)
+    editorClear();
+  for (i = 0; i < nLines; i++)
+  {
+    strcpy(p, aLine[i]);
+    p += strlen(p);
+    *p++ = '\n';
+  }
+  *p = '\0';
+  return sText;
+}
+
+int editorKeysDown()
+{
+  return nKeysDown;
+}
+
+int editorUnknownKeys()
+{
+  return nUnknownKeys;
+}
@@ -0,0 +1,42 @@
+/*
+  PUB! Programmable USB Button - A text editor driven by keyboard reports
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// The text editor that PROGRAM mode types into, modelled on the host: it
+// takes the keyboard reports the device sends (see "Keyboard Input Report"
+// in src/USBdsc.c) and applies each key as it is pressed, with a US
+// keyboard layout. The keys PROGRAM mode uses behave as in most editors:
+// HOME, END, UP, DOWN, LEFT and RIGHT (with SHIFT to select, and CTL+HOME
+// and CTL+END for the ends of the text), DELETE, BACKSPACE and ENTER.
+//
+// The HID spec does not say in what order a host handles the keys that one
+// report presses, so the editor can take them either first to last or last
+// to first. The device must type the same text both ways.
+
+#include <stdint.h>
+
+void editorClear(void);
+void editorSetReversed(int bReversed);  // Take the keys a report presses last to first
+void editorReport(const uint8_t * pReport, uint8_t len);  // Any report (only 'K' ones are used)
+const char * editorText(void);      // The text, with each line ended by \n
+int editorKeysDown(void);           // Keys the last report left pressed
+int editorUnknownKeys(void);        // Keys pressed that the editor does not know
@@ -0,0 +1,72 @@
+/*
+  PUB! Programmable USB Button - Host stand-ins for the mikroC built-ins
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+// What src/pub.c expects mikroC and the PIC18F25K50 to provide, for the
+// host build of the firmware (see device.h). The registers are plain
+// variables, and the library routines are in device.c.
+//
+// Note that int is 32 bits on the host but 16 bits on the device, so
+// 16-bit arithmetic that relies on wrapping round can behave differently.
+
+#include <stdint.h>
+
+#define main       deviceMain       // The firmware's main() and interrupt()
+#define interrupt  deviceInterrupt  // are called by device.c instead
+
+#define __FOSC__   48000            // Clock frequency in kHz (set in the project)
+
+#define Hi(x) (((uint8_t *)&(x))[1]) // Little-endian, as on the PIC
+#define Lo(x) (((uint8_t *)&(x))[0])
+
+typedef struct                      // What uint8_t cFlags is, given .Bn
+{
+  uint8_t B0:1, B1:1, B2:1, B3:1, B4:1, B5:1, B6:1, B7:1;
+} t_hostFlags;
+
+// Registers
+extern volatile uint8_t ANSELA, ANSELB, ANSELC, LATA, LATB, LATC, TRISA, TRISB, TRISC;
+extern volatile uint8_t OSCCON, OSCCON2, T0CON, T1CON, T3CON, TMR3H, TMR3L;
+
+// Register bits (the ones sbit names in pub.h included)
+extern volatile uint8_t RB4_bit, RB5_bit, RB6_bit, LATA0_bit, NOT_RBPU_bit;
+extern volatile uint8_t HFIOFS_bit, OSTS_bit, PLLEN_bit, SPLLMULT_bit, PLLRDY_bit;
+extern volatile uint8_t ACTEN_bit, ACTSRC_bit, UPUEN_bit, FSEN_bit;
+extern volatile uint8_t IOCIF_bit, IOCIE_bit, IOCB4_bit, IOCB5_bit, IOCB6_bit;
+extern volatile uint8_t TMR0IE_bit, TMR0IF_bit, TMR3IE_bit, TMR3IF_bit, TMR3ON_bit, PEIE_bit, GIE_bit;
+extern volatile uint8_t IDLEN_bit, IDLEIF_bit, ACTVIE_bit, ACTVIF_bit, SUSPND_bit;
+
+// Library routines
+void Delay_ms(uint16_t n);
+void Delay_us(uint16_t n);
+uint8_t EEPROM_Read(uint16_t addr);
+void EEPROM_Write(uint16_t addr, uint8_t b);
+void HID_Enable(void * pFromHost, void * pToHost);
+void HID_Disable(void);
+uint8_t HID_Read(void);
+uint8_t HID_Write(void * p, uint8_t len);
+void USB_Interrupt_Proc(void);
+void ByteToStr(uint8_t n, char * s);
+void ShortToStr(int8_t n, char * s);
+void WordToStr(uint16_t n, char * s);
+
+void hostSleep(void);               // asm sleep (see mikroc.sed)
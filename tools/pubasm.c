@@ -0,0 +1,763 @@
+/*
+  PUB! Programmable USB Button - Program assembler and disassembler
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+/*
+Function - Converts between a program written as text and the 256-byte
+           program image that tools/pubprog uploads to a PUB! device.
+
+           The descriptions, operands and encodings all come from
+           src/actions.h and src/usagenames.h, which the device also uses
+           (the names packed by tools/pubtext), so a listing made here is
+           exactly what the device types under "At Code Action".
+
+Build    - gcc -O2 -Wall -o pubasm tools/pubasm.c
+
+Usage    - pubasm SOURCE IMAGE      Assemble SOURCE into IMAGE
+           pubasm -l IMAGE          List IMAGE
+
+Source   - One statement per line. Each line may start with a label and
+           may end with a comment:
+
+             label:             Names the address of the next action
+             // comment         Ignored (to the end of the line)
+             "text"             Typed the way SAY types it (\" \\ \n and \t
+                                escapes). Text of 3 or more characters is
+                                packed two characters to an action after a
+                                "Text, length n" action; shorter text is
+                                one keystroke for each character
+             0006               An action given by its hex code
+             00 0006 c          A listing line: the code is used, and the
+                                rest of the line is ignored
+             CTL+SHIFT+Home     A keystroke with modifiers
+             Mute               A keystroke, or a System Control or
+                                Consumer Device function (in that order
+                                when the same name is used by more than
+                                one: use the hex code to pick another)
+             Let W = 05         An instruction, as listed
+             Wait 250 ms
+             Say in Decimal
+             Jump if Zero to label
+             Jump Relative by -3
+             Jump to label      Targets can be labels or hex addresses
+             Chain to program 01
+             Call to label      Play from label until a Return
+             Get W from R(X+02) Registers indexed by X
+             Let X = X - 1, Jump if Not Zero to label
+             Return
+
+           The focussed action is set to the end of the program, which is
+           where the device appends the next action.
+*/
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/actions.h"
+#include "../src/usagenames.h"
+
+#define ELEMENTS(array) (sizeof(array)/sizeof(array[0]))
+
+#define IMAGE_SIZE          256
+#define MAX_LABELS          256
+#define MAX_LABEL_LENGTH    32
+#define MAX_LINE_LENGTH     256
+
+typedef struct
+{
+  char sName[MAX_LABEL_LENGTH];
+  int addr;
+} t_label;
+
+t_label aLabel[MAX_LABELS];
+int nLabels;
+uint16_t aCode[MAX_ACTIONS];
+int nCode;                          // Number of actions assembled so far
+int bFinalPass;                     // Labels must all be known in the final pass
+const char * sSource;
+int nLine;
+
+
+__attribute__((noreturn)) void fail(const char * sFormat, ...)
+{
+  va_list args;
+  if (sSource)
+    fprintf(stderr, "%s:%d: ", sSource, nLine);
+  else
+    fprintf(stderr, "pubasm: ");
+  va_start(args, sFormat);
+  vfprintf(stderr, sFormat, args);
+  va_end(args);
+  fprintf(stderr, "\n");
+  exit(1);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Listing - this mirrors getUsageDesc() and sayUsage() in src/pub.c        */
+/* ------------------------------------------------------------------------ */
+
+const char * getKeyDesc(uint8_t mod, uint8_t usage)
+{
+  if ((mod & MODIFIER_LEFTSHIFT) && usage < ELEMENTS(SHIFTED_USB_DESC) && *SHIFTED_USB_DESC[usage])
+    return SHIFTED_USB_DESC[usage];
+  if (usage < ELEMENTS(UNSHIFTED_USB_DESC))
+    return UNSHIFTED_USB_DESC[usage];
+  return "";
+}
+
+const char * getUsageName(const t_usageName * pNames, unsigned nNames, uint16_t usage)
+{
+  unsigned i;
+  for (i = 0; i < nNames; i++)
+  {
+    if (pNames[i].usage == usage)
+      return pNames[i].sName;
+  }
+  return "";
+}
+
+const char * getUsageDesc(uint16_t code)
+{
+  uint8_t page = code >> 12;
+  uint8_t mod = (code >> 8) & 0xF;
+  uint8_t usage = code & 0xFF;
+
+  switch (page)
+  {
+    case PAGE_KEYBOARD:
+      return getKeyDesc(mod, usage);
+    case PAGE_SYSTEM_CONTROL:
+      return getUsageName(SYSTEM_CONTROL_DESC, ELEMENTS(SYSTEM_CONTROL_DESC), usage);
+    case PAGE_CONSUMER_DEVICE:
+      return getUsageName(CONSUMER_DEVICE_DESC, ELEMENTS(CONSUMER_DEVICE_DESC), code & 0xFFF);
+    case PAGE_TEXT:
+      return "Text, length ";
+    case PAGE_REGISTER:
+      return REGISTER_DESC[mod];
+    case PAGE_CONTROL:
+      return CONTROL_DESC[mod];
+    case PAGE_DO:
+      return DO_DESC[mod];
+    case PAGE_EXECUTE:
+      return EXECUTE_DESC[mod];
+    case PAGE_JUMP:
+      return JUMP_DESC[mod];
+    default:
+      return "";
+  }
+}
+
+void listOperand(uint8_t operand, uint8_t value)
+{
+  switch (operand)
+  {
+    case OPERAND_FORMAT:
+      printf("%s", FORMAT_DESC[value < ELEMENTS(FORMAT_DESC) ? value : FORMAT_HEX]);
+      break;
+    case OPERAND_MS:
+      printf("%u ms", value);
+      break;
+    case OPERAND_SEC:
+      printf("%u sec", value);
+      break;
+    case OPERAND_SIGNED:
+      printf(" by %d", (int8_t)value);
+      break;
+    case OPERAND_ADDRESS:
+      printf(" to %02X", value);
+      break;
+    case OPERAND_NONE:
+      break;
+    case OPERAND_OFFSET:
+      printf("%02X)", value);
+      break;
+    case OPERAND_HEX:
+    default:
+      printf("%02X", value);
+      break;
+  }
+}
+
+void listAction(uint8_t n, uint16_t code)
+{
+  uint8_t page = code >> 12;
+  uint8_t mod = (code >> 8) & 0xF;
+  uint8_t usage = code & 0xFF;
+  int i;
+
+  if (page == PAGE_DO)
+    printf("        ");
+  else
+    printf("%02X %04X ", n, code);
+  switch (page)
+  {
+    case PAGE_KEYBOARD:
+      for (i = 0; i < (int)ELEMENTS(MODIFIER_ORDER); i++)
+      {
+        if (mod & MODIFIER_ORDER[i])
+          printf("%s", MODIFIER_DESC[i]);
+      }
+      printf("%s", getUsageDesc(code));
+      break;
+
+    case PAGE_JUMP:
+      printf("%s", getUsageDesc(code));
+      listOperand(JUMP_OPERAND[mod], usage);
+      break;
+
+    case PAGE_EXECUTE:
+      printf("%s", getUsageDesc(code));
+      listOperand(EXECUTE_OPERAND[mod], usage);
+      break;
+
+    case PAGE_REGISTER:
+      printf("%s", getUsageDesc(code));
+      listOperand(REGISTER_OPERAND[mod], usage);
+      break;
+
+    case PAGE_CONTROL:
+      printf("%s", getUsageDesc(code));
+      listOperand(CONTROL_OPERAND[mod], usage);
+      break;
+
+    case PAGE_TEXT:
+      printf("%s%u", getUsageDesc(code), usage);
+      break;
+
+    case PAGE_DO:
+      printf("%s", getUsageDesc(code));
+      if (mod == DO_DELETE && n)
+        printf(" at %02X", usage >= n ? n-1 : usage);
+      else if (mod == DO_LOAD || mod == DO_SAVE)
+        printf("%02X", usage);
+      break;
+
+    default:
+      printf("%s", getUsageDesc(code));
+      break;
+  }
+  printf("\n");
+}
+
+int listableChar(uint8_t c)
+{
+  return c < ' ' || c > '~' ? '.' : c;
+}
+
+void listTextPart(uint8_t n, uint16_t code)
+{
+  // Mirrors sayTextPart(): the padding of an odd length run is not shown
+  printf("%02X %04X \"%c", n, code, listableChar(code >> 8));
+  if (code & 0xFF)
+    printf("%c", listableChar(code & 0xFF));
+  printf("\"\n");
+}
+
+void listImage(const uint8_t * pImage)
+{
+  int i;
+  int nTextEnd = 0;                 // Actions before this are part of a text run
+  uint16_t code;
+  printf("At Code Action\n");
+  for (i = 0; i < pImage[1] && i < MAX_ACTIONS; i++)
+  {
+    code = pImage[2+2*i] << 8 | pImage[3+2*i];
+    if (i < nTextEnd)
+      listTextPart(i, code);
+    else
+    {
+      listAction(i, code);
+      if (code >> 12 == PAGE_TEXT)
+        nTextEnd = i + 1 + TEXT_SLOTS(code & 0xFF);
+    }
+  }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Assembler                                                                */
+/* ------------------------------------------------------------------------ */
+
+const char * skipBlanks(const char * p)
+{
+  while (isspace((unsigned char)*p))
+    p++;
+  return p;
+}
+
+int isHexDigits(const char * p, int nMin, int nMax, unsigned * pValue)
+{
+  // TRUE if p is nMin to nMax hex digits and nothing else
+  int n;
+  char * pEnd;
+  for (n = 0; isxdigit((unsigned char)p[n]); n++);
+  if (n < nMin || n > nMax || p[n])
+    return 0;
+  *pValue = strtoul(p, &pEnd, 16);
+  return 1;
+}
+
+int isLabelName(const char * p, int n)
+{
+  int i;
+  if (n <= 0 || n >= MAX_LABEL_LENGTH || !(isalpha((unsigned char)p[0]) || p[0] == '_'))
+    return 0;
+  for (i = 1; i < n; i++)
+  {
+    if (!(isalnum((unsigned char)p[i]) || p[i] == '_'))
+      return 0;
+  }
+  return 1;
+}
+
+t_label * findLabel(const char * sName)
+{
+  int i;
+  for (i = 0; i < nLabels; i++)
+  {
+    if (!strcmp(aLabel[i].sName, sName))
+      return &aLabel[i];
+  }
+  return NULL;
+}
+
+void defineLabel(const char * p, int n)
+{
+  char sName[MAX_LABEL_LENGTH];
+  t_label * pLabel;
+  memcpy(sName, p, n);
+  sName[n] = '\0';
+  pLabel = findLabel(sName);
+  if (bFinalPass)
+    return;                         // Already defined in the first pass
+  if (pLabel)
+    fail("label '%s' is already defined", sName);
+  if (nLabels == MAX_LABELS)
+    fail("too many labels");
+  strcpy(aLabel[nLabels].sName, sName);
+  aLabel[nLabels].addr = nCode;
+  nLabels++;
+}
+
+int getTarget(const char * p, int * pAddr)
+{
+  // A jump target is a label or a hex address
+  t_label * pLabel;
+  unsigned value;
+  pLabel = findLabel(p);
+  if (pLabel)
+  {
+    *pAddr = pLabel->addr;
+    return 1;
+  }
+  if (isHexDigits(p, 1, 2, &value))
+  {
+    *pAddr = value;
+    return 1;
+  }
+  if (isLabelName(p, strlen(p)))
+  {
+    if (bFinalPass)
+      fail("label '%s' is not defined", p);
+    *pAddr = nCode;                 // Not known yet
+    return 1;
+  }
+  return 0;
+}
+
+int parseOperand(uint8_t operand, const char * p, uint8_t * pValue)
+{
+  // Parses the text after an instruction description
+  unsigned value;
+  char * pEnd;
+  char sOffset[3];
+  long n;
+  int addr;
+  int i;
+
+  switch (operand)
+  {
+    case OPERAND_FORMAT:
+      for (i = 0; i < (int)ELEMENTS(FORMAT_DESC); i++)
+      {
+        if (!strcmp(p, FORMAT_DESC[i]))
+        {
+          *pValue = i;
+          return 1;
+        }
+      }
+      return 0;
+
+    case OPERAND_MS:
+    case OPERAND_SEC:
+      if (!isdigit((unsigned char)*p))
+        return 0;
+      n = strtol(p, &pEnd, 10);
+      if (strcmp(skipBlanks(pEnd), operand == OPERAND_MS ? "ms" : "sec"))
+        return 0;
+      if (n > 255)
+        fail("%ld is too long to wait (the most is 255)", n);
+      *pValue = n;
+      return 1;
+
+    case OPERAND_SIGNED:
+      p = skipBlanks(p);
+      if (strncmp(p, "by", 2) || !isspace((unsigned char)p[2]))
+        return 0;
+      p = skipBlanks(p + 2);
+      n = strtol(p, &pEnd, 10);
+      if (pEnd != p && !*pEnd)
+        ;                           // A signed decimal offset
+      else if (getTarget(p, &addr))
+        n = addr - nCode;           // Offset to a label
+      else
+        return 0;
+      if (n < -128 || n > 127)
+        fail("the jump is too far (the offset must be -128 to 127)");
+      *pValue = (uint8_t)n;
+      return 1;
+
+    case OPERAND_ADDRESS:
+      p = skipBlanks(p);
+      if (strncmp(p, "to", 2) || !isspace((unsigned char)p[2]))
+        return 0;
+      if (!getTarget(skipBlanks(p + 2), &addr))
+        return 0;
+      *pValue = addr;
+      return 1;
+
+    case OPERAND_NONE:
+      if (*skipBlanks(p))
+        return 0;
+      *pValue = 0;
+      return 1;
+
+    case OPERAND_OFFSET:
+      n = strlen(p);
+      if (n < 2 || n > 3 || p[n-1] != ')')
+        return 0;
+      memcpy(sOffset, p, n-1);
+      sOffset[n-1] = '\0';
+      if (!isHexDigits(sOffset, 1, 2, &value))
+        return 0;
+      *pValue = value;
+      return 1;
+
+    case OPERAND_HEX:
+    default:
+      if (!isHexDigits(p, 1, 2, &value))
+        return 0;
+      *pValue = value;
+      return 1;
+  }
+}
+
+int parseInstruction(const char * p, uint16_t * pCode)
+{
+  // The longest description that p starts with, and whose operand parses,
+  // wins (so that "Let W = W + R05" is not taken as "Let W = " W + R05)
+  int nBest = -1;
+  int i;
+  int n;
+  uint8_t value;
+
+  for (i = 0; i < 16; i++)
+  {
+    n = strlen(EXECUTE_DESC[i]);
+    if (n > nBest && n && !strncmp(p, EXECUTE_DESC[i], n) &&
+        parseOperand(EXECUTE_OPERAND[i], p + n, &value))
+    {
+      nBest = n;
+      *pCode = PAGE_EXECUTE << 12 | i << 8 | value;
+    }
+    n = strlen(JUMP_DESC[i]);
+    if (n > nBest && n && !strncmp(p, JUMP_DESC[i], n) &&
+        parseOperand(JUMP_OPERAND[i], p + n, &value))
+    {
+      nBest = n;
+      *pCode = PAGE_JUMP << 12 | i << 8 | value;
+    }
+    n = strlen(REGISTER_DESC[i]);
+    if (n > nBest && n && !strncmp(p, REGISTER_DESC[i], n) &&
+        parseOperand(REGISTER_OPERAND[i], p + n, &value))
+    {
+      nBest = n;
+      *pCode = PAGE_REGISTER << 12 | i << 8 | value;
+    }
+    n = strlen(CONTROL_DESC[i]);
+    if (n > nBest && n && !strncmp(p, CONTROL_DESC[i], n) &&
+        parseOperand(CONTROL_OPERAND[i], p + n, &value))
+    {
+      nBest = n;
+      *pCode = PAGE_CONTROL << 12 | i << 8 | value;
+    }
+  }
+  return nBest >= 0;
+}
+
+int parseKeystroke(const char * p, uint16_t * pCode)
+{
+  uint8_t mod = 0;
+  int i;
+  int n;
+
+  do                                // Strip any modifiers, in any order
+  {
+    for (i = 0; i < (int)ELEMENTS(MODIFIER_DESC); i++)
+    {
+      n = strlen(MODIFIER_DESC[i]);
+      if (!strncmp(p, MODIFIER_DESC[i], n) && !(mod & MODIFIER_ORDER[i]))
+      {
+        mod |= MODIFIER_ORDER[i];
+        p += n;
+        break;
+      }
+    }
+  } while (i < (int)ELEMENTS(MODIFIER_DESC));
+
+  if (mod & MODIFIER_LEFTSHIFT)     // Shifted names first, as they are listed
+  {
+    for (i = 0; i < (int)ELEMENTS(SHIFTED_USB_DESC); i++)
+    {
+      if (*SHIFTED_USB_DESC[i] && !strcmp(p, SHIFTED_USB_DESC[i]))
+      {
+        *pCode = PAGE_KEYBOARD << 12 | mod << 8 | i;
+        return 1;
+      }
+    }
+  }
+  for (i = 0; i < (int)ELEMENTS(UNSHIFTED_USB_DESC); i++)
+  {
+    if (*UNSHIFTED_USB_DESC[i] && !strcmp(p, UNSHIFTED_USB_DESC[i]))
+    {
+      *pCode = PAGE_KEYBOARD << 12 | mod << 8 | i;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int parseFunction(const char * p, uint16_t * pCode)
+{
+  unsigned i;
+  for (i = 0; i < ELEMENTS(SYSTEM_CONTROL_DESC); i++)
+  {
+    if (!strcmp(p, SYSTEM_CONTROL_DESC[i].sName))
+    {
+      *pCode = PAGE_SYSTEM_CONTROL << 12 | SYSTEM_CONTROL_DESC[i].usage;
+      return 1;
+    }
+  }
+  for (i = 0; i < ELEMENTS(CONSUMER_DEVICE_DESC); i++)
+  {
+    if (!strcmp(p, CONSUMER_DEVICE_DESC[i].sName))
+    {
+      *pCode = PAGE_CONSUMER_DEVICE << 12 | CONSUMER_DEVICE_DESC[i].usage;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void emit(uint16_t code)
+{
+  if (nCode == MAX_ACTIONS)
+    fail("the program has more than %d actions", MAX_ACTIONS);
+  aCode[nCode++] = code;
+}
+
+void emitText(const char * p)
+{
+  // A packed text run takes one action more than half the length of the
+  // text, so short text is emitted as a keystroke for each character
+  uint8_t sText[MAX_TEXT_LENGTH];
+  int nLength = 0;
+  uint8_t c;
+  uint8_t usb;
+  int i;
+
+  for (p++; *p && *p != '"'; p++)
+  {
+    c = *p;
+    if (c == '\\')
+    {
+      switch (*++p)
+      {
+        case 'n':  c = '\n'; break;
+        case 't':  c = '\t'; break;
+        case '\\': c = '\\'; break;
+        case '"':  c = '"';  break;
+        default:   fail("unknown escape \\%c", *p);
+      }
+    }
+    if (c >= sizeof(ASCII_to_USB))
+      fail("character 0x%02X cannot be typed", c);
+    if (nLength == MAX_TEXT_LENGTH)
+      fail("the text is longer than %d characters", MAX_TEXT_LENGTH);
+    sText[nLength++] = c;
+  }
+  if (*p != '"' || *skipBlanks(p + 1))
+    fail("the text must end with \"");
+
+  if (nLength < 3)
+  {
+    for (i = 0; i < nLength; i++)
+    {
+      usb = ASCII_to_USB[sText[i]];
+      emit(PAGE_KEYBOARD << 12 | (usb & 0x80 ? MODIFIER_LEFTSHIFT : 0) << 8 | (usb & 0x7F));
+    }
+    return;
+  }
+  emit(PAGE_TEXT << 12 | nLength);
+  for (i = 0; i < nLength; i += 2)
+    emit(sText[i] << 8 | (i + 1 < nLength ? sText[i+1] : 0));
+}
+
+void assembleLine(char * p)
+{
+  char * q;
+  int n;
+  int bQuoted;
+  unsigned value;
+  uint16_t code;
+
+  bQuoted = 0;                      // Remove any comment
+  for (q = p; *q; q++)
+  {
+    if (*q == '"' && (q == p || q[-1] != '\\'))
+      bQuoted = !bQuoted;
+    if (!bQuoted && q[0] == '/' && q[1] == '/')
+    {
+      *q = '\0';
+      break;
+    }
+  }
+  for (n = strlen(p); n && isspace((unsigned char)p[n-1]); n--);
+  p[n] = '\0';
+  p = (char *)skipBlanks(p);
+
+  q = strchr(p, ':');               // Define any label
+  if (q && isLabelName(p, q - p))
+  {
+    defineLabel(p, q - p);
+    p = (char *)skipBlanks(q + 1);
+  }
+
+  if (!*p || !strcmp(p, "At Code Action"))
+    return;
+  if (*p == '"')
+  {
+    emitText(p);
+    return;
+  }
+  if (strlen(p) >= 7 && isxdigit((unsigned char)p[0]) && isxdigit((unsigned char)p[1]) && p[2] == ' ' &&
+      (p[7] == '\0' || p[7] == ' '))
+  {
+    char sCode[5];
+    memcpy(sCode, p + 3, 4);
+    sCode[4] = '\0';
+    if (isHexDigits(sCode, 4, 4, &value))
+    {
+      emit(value);                  // A listing line
+      return;
+    }
+  }
+  if (isHexDigits(p, 4, 4, &value))
+    emit(value);
+  else if (parseInstruction(p, &code) || parseKeystroke(p, &code) || parseFunction(p, &code))
+    emit(code);
+  else
+    fail("unknown action: %s", p);
+}
+
+void assemble(const char * sFile, uint8_t * pImage)
+{
+  FILE * f;
+  char sLine[MAX_LINE_LENGTH];
+  int i;
+
+  sSource = sFile;
+  for (bFinalPass = 0; bFinalPass <= 1; bFinalPass++)
+  {
+    f = fopen(sFile, "r");
+    if (!f)
+    {
+      perror(sFile);
+      exit(1);
+    }
+    nCode = 0;
+    nLine = 0;
+    while (fgets(sLine, sizeof(sLine), f))
+    {
+      nLine++;
+      assembleLine(sLine);
+    }
+    fclose(f);
+  }
+  sSource = NULL;
+
+  memset(pImage, 0, IMAGE_SIZE);
+  pImage[0] = nCode;                // Focus on the end of the program
+  pImage[1] = nCode;
+  for (i = 0; i < nCode; i++)
+  {
+    pImage[2+2*i] = aCode[i] >> 8;
+    pImage[3+2*i] = aCode[i] & 0xFF;
+  }
+}
+
+void usage()
+{
+  fprintf(stderr,
+    "Usage: pubasm SOURCE IMAGE    Assemble SOURCE into IMAGE\n"
+    "       pubasm -l IMAGE        List IMAGE\n");
+  exit(2);
+}
+
+int main(int argc, char ** argv)
+{
+  uint8_t image[IMAGE_SIZE];
+  FILE * f;
+
+  if (argc != 3)
+    usage();
+  if (!strcmp(argv[1], "-l"))
+  {
+    f = fopen(argv[2], "rb");
+    if (!f || fread(image, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+      fail("cannot read a 256-byte image from %s", argv[2]);
+    fclose(f);
+    listImage(image);
+  }
+  else
+  {
+    assemble(argv[1], image);
+    f = fopen(argv[2], "wb");
+    if (!f || fwrite(image, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+      fail("cannot write %s", argv[2]);
+    fclose(f);
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+  PUB! Programmable USB Button - Benchmarks
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+/*
+Function - Measures typical workloads on the firmware built for the host
+           (see tools/host/device.h), so that a change to the firmware
+           can be judged by the numbers before and after:
+
+             Reports    Reports sent to the host
+             ms         Simulated milliseconds, with the host polling
+                        for a report every millisecond
+             EEPROM     Bytes written to the on-chip EEPROM
+
+           The numbers depend only on the firmware, so they are the same
+           on every run.
+
+Build    - make -C tools pubbench
+
+Usage    - pubbench
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host/device.h"
+
+#define PROGRAM_SIZE  125           // MAX_ACTIONS in src/actions.h
+#define SAVED_SIZE    61            // MAX_SAVED_ACTIONS in src/storage.h (on-chip EEPROM)
+
+const char MACRO[] =                // 127 keys, shifted and not
+  "The quick brown fox jumps over the lazy dog. THE QUICK BROWN FOX "
+  "JUMPS OVER THE LAZY DOG! 0123456789 (sphinx of black quartz)..";
+
+uint16_t aProgram[PROGRAM_SIZE];
+
+
+void report(const char * sName)
+{
+  printf("%-28s %8ld %8ld %8ld\n", sName,
+    deviceCounts.nReports, deviceCounts.nMs, deviceCounts.nEEPROMWrites);
+}
+
+int makeMacro()
+{
+  // A Text action (PAGE_TEXT) and the characters two to an action
+  int n;
+  int i;
+  n = 0;
+  aProgram[n++] = 0x3000 | (sizeof(MACRO) - 1);
+  for (i = 0; i < (int)sizeof(MACRO) - 1; i += 2)
+    aProgram[n++] = (uint8_t)MACRO[i] << 8 | (uint8_t)MACRO[i+1];
+  return n;
+}
+
+int makeKeystrokes()
+{
+  // A whole program of keystrokes (PAGE_KEYBOARD), some with modifiers
+  int i;
+  for (i = 0; i < PROGRAM_SIZE; i++)
+    aProgram[i] = (i % 4) << 8 | (0x04 + i % 26);
+  return PROGRAM_SIZE;
+}
+
+int main()
+{
+  deviceStart(NULL);
+  printf("%-28s %8s %8s %8s\n", "Benchmark", "Reports", "ms", "EEPROM");
+
+  deviceSetActions(aProgram, makeMacro());
+  deviceResetCounts();
+  devicePlay();
+  report("Play a 127-key macro");
+
+  deviceSetActions(aProgram, makeKeystrokes());
+  deviceResetCounts();
+  deviceRedisplay();
+  report("Redisplay 125 actions");
+
+  deviceResetCounts();
+  deviceDeleteAction(0);
+  report("Delete action 0");
+
+  deviceSetActions(aProgram, SAVED_SIZE + 1);
+  deviceSave(0);
+  deviceRedisplay();
+  deviceDeleteAction(0);
+  deviceResetCounts();
+  deviceSave(0);
+  report("Save 61 actions, 1 deleted");
+  return 0;
+}
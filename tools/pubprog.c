@@ -0,0 +1,379 @@
+/*
+  PUB! Programmable USB Button - Program uploader/downloader for Linux
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+/*
+Function - Reads and writes the program image of a PUB! device using the
+           vendor-defined program report (see "Program Output Report" in
+           src/USBdsc.c) through the Linux hidraw driver, so no driver or
+           knob twiddling is needed.
+
+           The program image is the 256 bytes that getImageByte() and
+           setImageByte() in src/pub.c read and write:
+
+             Offset  Content
+             ------  -------------------------------------------
+               00    Focussed action
+               01    Number of actions (at most MAX_ACTIONS, 125)
+               02    Action 00 (high byte, low byte)
+               04    Action 01
+               ..    ...
+               FA    Action 7C
+               FC    Padding (zeros)
+
+Build    - make -C tools pubprog
+
+Usage    - pubprog [-d /dev/hidrawN | --simulate FILE] [-p N] COMMAND
+
+           Commands:
+             dump               List the actions on the device
+             backup FILE        Copy the device image to FILE
+             upload FILE        Copy FILE to the device, verify it, and
+                                save it as program N (0 by default)
+             verify FILE        Compare the device image with FILE
+
+           -p N first loads program N (a hex number) on the device, so that
+           dump, backup and verify work on that program. It stays loaded,
+           so it is the one the knob plays afterwards.
+
+           The device must be in RUN mode. Without -d, the first hidraw
+           device with the PUB! vendor and product id is used (the user
+           needs read/write access to it, for example via a udev rule).
+
+           --simulate FILE uses FILE as the device instead, so that scripts
+           can be tried out without a device attached. The device is the
+           firmware itself built for the host with FILE as its program
+           storage (see STORAGE_FILE in src/storage.h and tools/host/device.h),
+           so it starts with program 0 loaded. A missing FILE behaves like a
+           device with no actions.
+*/
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/hidraw.h>
+
+#include "host/device.h"
+
+// These must match src/USBdsc.c, src/USBdsc.h and src/pub.h
+#define USB_VENDOR_ID       0x5055  // 'PU'
+#define USB_PRODUCT_ID      0x4221  // 'B!'
+#define REPORT_ID_PROGRAM   'P'
+#define PROGRAM_BLOCK_SIZE  16
+#define PROGRAM_READ        'R'
+#define PROGRAM_WRITE       'W'
+#define PROGRAM_SAVE        'S'
+#define PROGRAM_LOAD        'L'
+#define PROGRAM_OK          0x0
+#define PROGRAM_BUSY        0x1
+#define PROGRAM_INVALID     0x2
+
+#define IMAGE_SIZE          256
+#define MAX_ACTIONS         125     // As in src/actions.h
+#define TIMEOUT_READS       100     // Reports to skip while waiting for a reply
+#define TIMEOUT_MS          2000    // Time to wait for each report (an EEPROM save takes about 1 s)
+
+typedef struct
+{
+  uint8_t reportId;
+  uint8_t command;
+  uint8_t offset;
+  uint8_t status;
+  uint8_t data[PROGRAM_BLOCK_SIZE];
+} t_programReport;
+
+int hDevice = -1;                   // hidraw device handle
+const char * sSimulate = NULL;      // Storage file of the simulated device, if any
+
+
+__attribute__((noreturn)) void fail(const char * sMessage)
+{
+  fprintf(stderr, "pubprog: %s\n", sMessage);
+  exit(1);
+}
+
+int openDevice(const char * sPath)
+{
+  DIR * pDir;
+  struct dirent * pEntry;
+  struct hidraw_devinfo info;
+  char sName[5+sizeof(pEntry->d_name)];
+  int h;
+
+  if (sPath)
+  {
+    h = open(sPath, O_RDWR);
+    if (h < 0)
+      perror(sPath);
+    return h;
+  }
+  pDir = opendir("/dev");
+  if (!pDir)
+    return -1;
+  h = -1;
+  while (h < 0 && (pEntry = readdir(pDir)) != NULL)
+  {
+    if (strncmp(pEntry->d_name, "hidraw", 6))
+      continue;
+    snprintf(sName, sizeof(sName), "/dev/%s", pEntry->d_name);
+    h = open(sName, O_RDWR);
+    if (h < 0)
+      continue;
+    if (ioctl(h, HIDIOCGRAWINFO, &info) < 0 ||
+        (uint16_t)info.vendor != USB_VENDOR_ID ||
+        (uint16_t)info.product != USB_PRODUCT_ID)
+    {
+      close(h);
+      h = -1;
+    }
+  }
+  closedir(pDir);
+  return h;
+}
+
+void doCommand(uint8_t command, uint8_t offset, const uint8_t * pData, uint8_t * pResult)
+{
+  t_programReport request;
+  t_programReport reply;
+  struct pollfd pfd;
+  int i;
+
+  memset(&request, 0, sizeof(request));
+  request.reportId = REPORT_ID_PROGRAM;
+  request.command = command;
+  request.offset = offset;
+  if (pData)
+    memcpy(request.data, pData, PROGRAM_BLOCK_SIZE);
+
+  if (sSimulate)
+  {
+    deviceProgramCommand((uint8_t *)&request, (uint8_t *)&reply);
+  }
+  else
+  {
+    if (write(hDevice, &request, sizeof(request)) != sizeof(request))
+      fail("cannot send a report to the device");
+    pfd.fd = hDevice;
+    pfd.events = POLLIN;
+    for (i = 0; i < TIMEOUT_READS; i++) // Skip any keyboard reports until the reply arrives
+    {
+      if (poll(&pfd, 1, TIMEOUT_MS) <= 0)
+        fail("no reply from the device");
+      if (read(hDevice, &reply, sizeof(reply)) == sizeof(reply) &&
+          reply.reportId == REPORT_ID_PROGRAM &&
+          reply.command == command &&
+          reply.offset == offset)
+        break;
+    }
+    if (i == TIMEOUT_READS)
+      fail("no reply from the device");
+  }
+
+  switch (reply.status)
+  {
+    case PROGRAM_OK:
+      break;
+    case PROGRAM_BUSY:
+      fail("the device is in PROGRAM mode (press and hold the knob to exit)");
+    case PROGRAM_INVALID:
+      fail("the device rejected the command or data");
+    default:
+      fail("unexpected status from the device");
+  }
+  if (pResult)
+    memcpy(pResult, reply.data, PROGRAM_BLOCK_SIZE);
+}
+
+void readImage(uint8_t * pImage)
+{
+  int offset;
+  for (offset = 0; offset < IMAGE_SIZE; offset += PROGRAM_BLOCK_SIZE)
+  {
+    doCommand(PROGRAM_READ, offset, NULL, pImage + offset);
+  }
+}
+
+void writeImage(const uint8_t * pImage)
+{
+  int offset;
+  for (offset = 0; offset < IMAGE_SIZE; offset += PROGRAM_BLOCK_SIZE)
+  {
+    doCommand(PROGRAM_WRITE, offset, pImage + offset, NULL);
+  }
+}
+
+void readFile(const char * sPath, uint8_t * pImage)
+{
+  FILE * f;
+  f = fopen(sPath, "rb");
+  if (!f)
+  {
+    perror(sPath);
+    exit(1);
+  }
+  if (fread(pImage, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+    fail("the image file must be 256 bytes long");
+  fclose(f);
+  if (pImage[0] > MAX_ACTIONS || pImage[1] > MAX_ACTIONS)
+    fail("the image file has an invalid number of actions");
+}
+
+void writeFile(const char * sPath, const uint8_t * pImage)
+{
+  FILE * f;
+  f = fopen(sPath, "wb");
+  if (!f || fwrite(pImage, 1, IMAGE_SIZE, f) != IMAGE_SIZE)
+  {
+    perror(sPath);
+    exit(1);
+  }
+  fclose(f);
+}
+
+int compareImages(const uint8_t * pDevice, const uint8_t * pFile)
+{
+  // Only the focussed action, the count and the actions in use matter
+  int n;
+  n = 2 + 2 * pFile[1];
+  return memcmp(pDevice, pFile, n);
+}
+
+void dumpImage(const uint8_t * pImage)
+{
+  int i;
+  printf("At Code\n");
+  for (i = 0; i < pImage[1]; i++)
+  {
+    printf("%02X %02X%02X\n", i, pImage[2+2*i], pImage[3+2*i]);
+  }
+  printf("%d actions, focus at %02X\n", pImage[1], pImage[0]);
+}
+
+void usage()
+{
+  fprintf(stderr,
+    "Usage: pubprog [-d /dev/hidrawN | --simulate FILE] [-p N] COMMAND\n"
+    "  dump           List the actions on the device\n"
+    "  backup FILE    Copy the device image to FILE\n"
+    "  upload FILE    Copy FILE to the device, verify it and save it as program N\n"
+    "  verify FILE    Compare the device image with FILE\n"
+    "  -p N           Load program N (hex) first\n");
+  exit(2);
+}
+
+int main(int argc, char ** argv)
+{
+  const char * sDevice = NULL;
+  const char * sCommand;
+  const char * sFile = NULL;
+  int nProgram = -1;                // Program to load first (none by default)
+  char * pEnd;
+  uint8_t device[IMAGE_SIZE];
+  uint8_t file[IMAGE_SIZE];
+  FILE * f;
+  int i;
+
+  for (i = 1; i < argc && argv[i][0] == '-'; i++)
+  {
+    if (!strcmp(argv[i], "-d") && i+1 < argc)
+      sDevice = argv[++i];
+    else if (!strcmp(argv[i], "--simulate") && i+1 < argc)
+      sSimulate = argv[++i];
+    else if (!strcmp(argv[i], "-p") && i+1 < argc)
+    {
+      nProgram = strtol(argv[++i], &pEnd, 16);
+      if (*pEnd || nProgram < 0 || nProgram > 0xFF)
+        usage();
+    }
+    else
+      usage();
+  }
+  if (i >= argc)
+    usage();
+  sCommand = argv[i++];
+  if (i < argc)
+    sFile = argv[i++];
+  if (i < argc)
+    usage();
+
+  if (sSimulate)
+  {
+    f = fopen(sSimulate, "ab");     // The firmware cannot report a file it cannot write
+    if (!f)
+      fail("cannot write the simulated device file");
+    fclose(f);
+    deviceStart(sSimulate);         // Which loads program 0, as at power up
+  }
+  else
+  {
+    hDevice = openDevice(sDevice);
+    if (hDevice < 0)
+      fail("no PUB! device found");
+  }
+  if (nProgram >= 0 && strcmp(sCommand, "upload"))
+    doCommand(PROGRAM_LOAD, nProgram, NULL, NULL);
+
+  if (!strcmp(sCommand, "dump") && !sFile)
+  {
+    readImage(device);
+    dumpImage(device);
+  }
+  else if (!strcmp(sCommand, "backup") && sFile)
+  {
+    readImage(device);
+    writeFile(sFile, device);
+  }
+  else if (!strcmp(sCommand, "upload") && sFile)
+  {
+    readFile(sFile, file);
+    writeImage(file);
+    readImage(device);
+    if (compareImages(device, file))
+      fail("verify failed after upload (not saved)");
+    doCommand(PROGRAM_SAVE, nProgram >= 0 ? nProgram : 0, NULL, NULL);
+    printf("Uploaded and saved %d actions as program %02X\n", file[1], nProgram >= 0 ? nProgram : 0);
+  }
+  else if (!strcmp(sCommand, "verify") && sFile)
+  {
+    readFile(sFile, file);
+    readImage(device);
+    if (compareImages(device, file))
+    {
+      printf("Different\n");
+      return 1;
+    }
+    printf("Same\n");
+  }
+  else
+  {
+    usage();
+  }
+  if (hDevice >= 0)
+    close(hDevice);
+  return 0;
+}
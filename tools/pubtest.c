@@ -0,0 +1,274 @@
+/*
+  PUB! Programmable USB Button - Tests of what PROGRAM mode types
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+/*
+Function - Runs the firmware built for the host (see tools/host/device.h)
+           against a simulated host text editor (tools/host/editor.h) that
+           applies the keyboard reports the device sends, and checks that
+           PROGRAM mode leaves the listing the editor shows correct:
+
+           - A redisplay types the listing exactly as expected
+           - After inserting, updating and deleting actions, which only
+             retype the lines that changed, the listing is the same as a
+             redisplay from scratch would type, and it took fewer reports
+           - No key is left pressed, and no key the editor does not know
+             is sent
+           - A program too big for two copies in the on-chip EEPROM is not
+             saved, and nothing is written
+           - Turning the knob twice, on the page and then on the usage,
+             leaves just the last choice on the selection line, and the
+             info line as it was
+
+           The checks are repeated with the host polling for a report every
+           8 ms rather than every millisecond, once the device has measured
+           that rate and paces its reports to it. That must change only how
+           long things take. They are repeated again with the editor taking
+           the keys that one report presses last to first, since the HID
+           spec does not say in what order a host takes them.
+
+Build    - make -C tools pubtest
+
+Usage    - pubtest
+
+           Prints each check that fails, and exits with 1 if any did.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host/device.h"
+#include "host/editor.h"
+
+#define INFO_LINE     2             // As in src/pub.h
+#define SELECTION_LINE 3
+#define LISTING_LINE  5             // "At Code Action" (START_ACTIONS_LINE-1)
+
+const char LISTING[] =
+  "At Code Action\n"
+  "00 0004 a\n"
+  "01 0205 CTL+b\n"
+  "02 1001 Power Down\n"
+  "03 3008 Text, length 8\n"
+  "04 4865 \"He\"\n"
+  "05 6C6C \"ll\"\n"
+  "06 6F21 \"o!\"\n"
+  "07 2021 \" !\"\n"
+  "08 0006 c\n";
+
+char sListing[65536];
+char sExpected[65536];
+long nRedisplayReports;             // With the host polling every millisecond
+int bReversed;                      // Whether the editor takes new keys last to first
+int nFailures;
+
+
+void check(int bOK, const char * sCheck)
+{
+  if (!bOK)
+  {
+    printf("FAILED: %s (polling every %ld ms%s)\n", sCheck, nDevicePollMs,
+      bReversed ? ", keys reversed" : "");
+    nFailures++;
+  }
+}
+
+const char * getLine(int nLine, char * sBuffer)
+{
+  // One line of the editor's text (the first is 1), without the newline
+  const char * p = editorText();
+  int i;
+  for (i = 1; i < nLine && p; i++)
+  {
+    p = strchr(p, '\n');
+    if (p)
+      p++;
+  }
+  strcpy(sBuffer, p ? p : "");
+  sBuffer[strcspn(sBuffer, "\n")] = '\0';
+  return sBuffer;
+}
+
+void checkLine(int nLine, const char * sWanted, const char * sCheck)
+{
+  getLine(nLine, sListing);
+  check(strcmp(sListing, sWanted) == 0, sCheck);
+  if (strcmp(sListing, sWanted))
+    printf("Line %d: \"%s\"\nWanted: \"%s\"\n", nLine, sListing, sWanted);
+}
+
+const char * getListing(char * sBuffer)
+{
+  // The editor's text from the "At Code Action" line on
+  const char * p = editorText();
+  int i;
+  for (i = 1; i < LISTING_LINE && p; i++)
+  {
+    p = strchr(p, '\n');
+    if (p)
+      p++;
+  }
+  strcpy(sBuffer, p ? p : "");
+  return sBuffer;
+}
+
+void checkEditor(const char * sAfter)
+{
+  // The listing must be what a redisplay from scratch types, and typing
+  // just the changes must have cost less than that
+  char sCheck[80];
+  long nReports;
+
+  nReports = deviceCounts.nReports;
+  getListing(sListing);
+  sprintf(sCheck, "%s: no keys left down", sAfter);
+  check(editorKeysDown() == 0, sCheck);
+  sprintf(sCheck, "%s: no unknown keys", sAfter);
+  check(editorUnknownKeys() == 0, sCheck);
+
+  editorClear();
+  deviceResetCounts();
+  deviceRedisplay();
+  sprintf(sCheck, "%s: listing as redisplayed", sAfter);
+  check(strcmp(sListing, getListing(sExpected)) == 0, sCheck);
+  if (strcmp(sListing, sExpected))
+    printf("Listing:\n%sRedisplayed:\n%s", sListing, sExpected);
+  sprintf(sCheck, "%s: fewer reports than a redisplay", sAfter);
+  check(nReports < deviceCounts.nReports, sCheck);
+}
+
+void test()
+{
+  const uint16_t aProgram[] =
+  {
+    0x0004,                         // a
+    0x0205,                         // CTL+b
+    0x1001,                         // Power Down
+    0x3008, 0x4865, 0x6C6C, 0x6F21, 0x2021, // Text: "Hello! !"
+    0x0006,                         // c
+  };
+  long nReports;
+  long nMs;
+
+  editorClear();
+  deviceSetActions(aProgram, sizeof(aProgram) / sizeof(aProgram[0]));
+  deviceResetCounts();
+  deviceRedisplay();
+  nReports = deviceCounts.nReports;
+  nMs = deviceCounts.nMs;
+  check(editorKeysDown() == 0, "Redisplay: no keys left down");
+  check(editorUnknownKeys() == 0, "Redisplay: no unknown keys");
+  check(strcmp(getListing(sListing), LISTING) == 0, "Redisplay: listing as expected");
+  if (!nRedisplayReports)
+    nRedisplayReports = nReports;
+  check(nReports == nRedisplayReports, "Redisplay: reports whatever the polling");
+  check(nMs >= (nReports - 1) * nDevicePollMs, "Redisplay: one report per poll");
+
+  deviceResetCounts();
+  deviceStoreAction(9, 0x0007);     // Append d
+  checkEditor("Append");
+
+  deviceResetCounts();
+  deviceStoreAction(1, 0x0108);     // SHIFT+e over CTL+b
+  checkEditor("Update");
+
+  deviceResetCounts();
+  deviceStoreAction(3, 0x0009);     // f over the text run
+  checkEditor("Update a text run");
+
+  deviceResetCounts();
+  deviceDeleteAction(0);
+  checkEditor("Delete the first action");
+
+  deviceResetCounts();
+  deviceDeleteAction(2);
+  checkEditor("Delete a middle action");
+
+  deviceResetCounts();
+  deviceDeleteAction(3);
+  checkEditor("Delete the last action");
+}
+
+void testTurns()
+{
+  // Each turn of the knob retypes the selection line over the last one,
+  // which it leaves selected. It must replace it, not add to it
+  const uint16_t aProgram[] = { 0x0004 };  // a
+
+  editorClear();
+  deviceSetActions(aProgram, 1);
+  deviceRedisplay();
+  deviceTurn(1);
+  deviceTurn(1);
+  checkLine(SELECTION_LINE, "   2    Set Consumer Device Command at 01",
+    "Turn the page twice: selection line");
+  checkLine(INFO_LINE, "Main:   Turn=Select, Press=OK, Press+Turn=Set At, Press+Hold=Exit",
+    "Turn the page twice: info line");
+
+  deviceChoosePage();
+  deviceTurn(1);
+  deviceTurn(1);
+  checkLine(SELECTION_LINE, "01 20B0 Play",
+    "Turn the usage twice: selection line");
+  checkLine(INFO_LINE, "Cons:   Turn=Select, Press=OK, Press+Hold=Return",
+    "Turn the usage twice: info line");
+  check(editorKeysDown() == 0, "Turn: no keys left down");
+  check(editorUnknownKeys() == 0, "Turn: no unknown keys");
+}
+
+void testSave()
+{
+  // Two copies of 61 actions fill the on-chip EEPROM
+  uint16_t aProgram[62];
+  int i;
+
+  for (i = 0; i < 62; i++)
+    aProgram[i] = 0x0004;           // a
+  deviceSetActions(aProgram, 61);
+  deviceResetCounts();
+  check(deviceSave(0), "Save 61 actions");
+  deviceSetActions(aProgram, 62);
+  deviceResetCounts();
+  check(!deviceSave(0), "Save 62 actions: refused");
+  check(deviceCounts.nEEPROMWrites == 0, "Save 62 actions: nothing written");
+}
+
+int main()
+{
+  deviceStart(NULL);
+  pDeviceReportHandler = editorReport;
+  test();
+  testTurns();
+  testSave();
+  nDevicePollMs = 8;
+  check(deviceCalibrate() == nDevicePollMs, "Calibrate: the rate the host polls at");
+  test();
+  testTurns();
+  bReversed = 1;
+  editorSetReversed(bReversed);
+  test();
+  testTurns();
+  if (!nFailures)
+    printf("All checks passed\n");
+  return nFailures ? 1 : 0;
+}
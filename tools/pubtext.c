@@ -0,0 +1,444 @@
+/*
+  PUB! Programmable USB Button - Usage name packer
+  Copyright (C) 2010-2014 Andrew J. Armstrong
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+  02111-1307  USA
+
+  Author:
+  Andrew J. Armstrong <androidarmstrong@gmail.com>
+*/
+
+/*
+Function - Packs the usage names in src/usagenames.h into src/usagetext.h,
+           which is what the device types them from.
+
+           As arrays of pointers the names cost a 2-byte pointer for every
+           usage, named or not, plus every copy of every name. Packed, they
+           are one pool of bytes and a 16-bit offset into it for each usage:
+
+           - Each name is a run of bytes ended by 0. A byte below 0x80 is a
+             character. A byte 0x80+n stands for token n: a fragment that
+             many names share (such as "Menu" or "KP "), stored once in the
+             pool at offset USAGE_TOKEN[n].
+           - Names that are the same, or the tail of a longer name, are
+             stored once.
+           - Offset 0 is the empty name, so a usage with no name has 0.
+
+           Tokens are chosen greedily: each round picks the fragment that
+           saves the most bytes, until none saves any or all 128 are used.
+
+           The system control and consumer device names are listed with
+           their usages, so SYSTEM_CONTROL_USAGE and CONSUMER_DEVICE_USAGE
+           (the usages the device steps through) are written here from the
+           same entries as their names. Each must be in ascending order.
+
+Build    - gcc -O2 -Wall -o pubtext tools/pubtext.c
+
+Usage    - pubtext > src/usagetext.h
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/actions.h"
+#include "../src/usagenames.h"
+
+#define ELEMENTS(array) (sizeof(array)/sizeof(array[0]))
+
+#define MAX_NAMES           512
+#define MAX_NAME_LENGTH     64
+#define MAX_TOKENS          128
+#define MAX_TOKEN_LENGTH    16
+#define MAX_POOL            8192
+#define HASH_SIZE           (1 << 18)
+#define TOKEN               0x80    // Bytes from here up are tokens
+
+typedef struct
+{
+  const char * sName;               // The name as written in usagenames.h
+  uint8_t a[MAX_NAME_LENGTH];       // The name with tokens in it
+  int n;
+  int offset;                       // Where it ends up in the pool
+} t_name;
+
+typedef struct
+{
+  uint8_t a[MAX_TOKEN_LENGTH];      // A fragment of a name (no tokens in it)
+  int n;                            // 0 if this slot is free
+  int count;                        // Times it occurs without overlapping
+  int nLastName;                    // Where it was last counted
+  int nLastEnd;
+} t_fragment;
+
+typedef struct
+{
+  const char * sName;
+  const char * const * pDesc;       // The names, indexed by usage...
+  const t_usageName * pUsageName;   // ...or listed with their usages
+  const char * sUsageName;          // What to call the usages listed
+  int nDesc;
+} t_table;
+
+const t_table TABLE[] =
+{
+  { "UNSHIFTED_USB_TEXT",  UNSHIFTED_USB_DESC, NULL,                 NULL,                    ELEMENTS(UNSHIFTED_USB_DESC)   },
+  { "SHIFTED_USB_TEXT",    SHIFTED_USB_DESC,   NULL,                 NULL,                    ELEMENTS(SHIFTED_USB_DESC)     },
+  { "SYSTEM_CONTROL_TEXT", NULL,               SYSTEM_CONTROL_DESC,  "SYSTEM_CONTROL_USAGE",  ELEMENTS(SYSTEM_CONTROL_DESC)  },
+  { "CONSUMER_DEVICE_TEXT",NULL,               CONSUMER_DEVICE_DESC, "CONSUMER_DEVICE_USAGE", ELEMENTS(CONSUMER_DEVICE_DESC) },
+};
+
+t_name aName[MAX_NAMES];            // Each different non-empty name
+int nNames;
+t_name aToken[MAX_TOKENS];          // Each token, as a name of its own
+int nTokens;
+t_fragment aFragment[HASH_SIZE];
+uint8_t aPool[MAX_POOL];
+int nPool;
+
+
+__attribute__((noreturn)) void fail(const char * sMessage, const char * sName)
+{
+  fprintf(stderr, "pubtext: %s: \"%s\"\n", sMessage, sName);
+  exit(1);
+}
+
+const char * getDesc(const t_table * t, int i)
+{
+  return t->pDesc ? t->pDesc[i] : t->pUsageName[i].sName;
+}
+
+t_name * findName(const char * sName)
+{
+  int i;
+  for (i = 0; i < nNames; i++)
+  {
+    if (!strcmp(aName[i].sName, sName))
+      return &aName[i];
+  }
+  return NULL;
+}
+
+void addName(const char * sName)
+{
+  t_name * p;
+  const char * q;
+  if (!*sName || findName(sName))
+    return;
+  if (nNames == MAX_NAMES)
+    fail("too many names, at", sName);
+  if (strlen(sName) >= MAX_NAME_LENGTH)
+    fail("name too long", sName);
+  p = &aName[nNames++];
+  p->sName = sName;
+  for (q = sName; *q; q++)
+  {
+    if ((uint8_t)*q >= TOKEN)
+      fail("name is not plain ASCII", sName);
+    p->a[p->n++] = *q;
+  }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Choosing the tokens                                                      */
+/* ------------------------------------------------------------------------ */
+
+t_fragment * findFragment(const uint8_t * a, int n)
+{
+  uint32_t h;
+  int i;
+  t_fragment * p;
+  h = 2166136261u;                  // FNV-1a
+  for (i = 0; i < n; i++)
+    h = (h ^ a[i]) * 16777619u;
+  for (h &= HASH_SIZE - 1; ; h = (h + 1) & (HASH_SIZE - 1))
+  {
+    p = &aFragment[h];
+    if (!p->n)
+    {
+      memcpy(p->a, a, n);
+      p->n = n;
+      p->nLastName = -1;
+      return p;
+    }
+    if (p->n == n && !memcmp(p->a, a, n))
+      return p;
+  }
+}
+
+int getSaving(const t_fragment * p)
+{
+  // Each use saves all but the token byte, and the token costs its own
+  // copy in the pool (with its 0), plus its entry in USAGE_TOKEN
+  return p->count * (p->n - 1) - (p->n + 1) - 2;
+}
+
+t_fragment * findBestFragment()
+{
+  t_fragment * p;
+  t_fragment * pBest;
+  int i;
+  int j;
+  int n;
+  memset(aFragment, 0, sizeof(aFragment));
+  for (i = 0; i < nNames; i++)
+  {
+    for (j = 0; j < aName[i].n; j++)
+    {
+      for (n = 2; n <= MAX_TOKEN_LENGTH && j + n <= aName[i].n && aName[i].a[j+n-1] < TOKEN; n++)
+      {
+        if (aName[i].a[j] >= TOKEN)
+          break;
+        p = findFragment(&aName[i].a[j], n);
+        if (p->nLastName != i || j >= p->nLastEnd)
+        {
+          p->count++;
+          p->nLastName = i;
+          p->nLastEnd = j + n;
+        }
+      }
+    }
+  }
+  pBest = NULL;
+  for (i = 0; i < HASH_SIZE; i++)
+  {
+    p = &aFragment[i];
+    if (p->n && getSaving(p) > 0)
+    {
+      if (!pBest || getSaving(p) > getSaving(pBest) ||
+          (getSaving(p) == getSaving(pBest) && memcmp(p->a, pBest->a, p->n < pBest->n ? p->n : pBest->n) < 0))
+        pBest = p;
+    }
+  }
+  return pBest;
+}
+
+void useToken(const t_fragment * p)
+{
+  t_name * q;
+  int i;
+  int j;
+  int n;
+  q = &aToken[nTokens];
+  memcpy(q->a, p->a, p->n);
+  q->n = p->n;
+  for (i = 0; i < nNames; i++)
+  {
+    q = &aName[i];
+    for (j = 0, n = 0; j < q->n; )
+    {
+      if (j + p->n <= q->n && !memcmp(&q->a[j], p->a, p->n))
+      {
+        q->a[n++] = TOKEN + nTokens;
+        j += p->n;
+      }
+      else
+        q->a[n++] = q->a[j++];
+    }
+    q->n = n;
+  }
+  nTokens++;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Laying out the pool                                                      */
+/* ------------------------------------------------------------------------ */
+
+int byLength(const void * a, const void * b)
+{
+  const t_name * p = *(const t_name * const *)a;
+  const t_name * q = *(const t_name * const *)b;
+  if (p->n != q->n)
+    return q->n - p->n;
+  return memcmp(p->a, q->a, p->n);
+}
+
+void place(t_name * p, t_name ** apPlaced, int * pnPlaced)
+{
+  int i;
+  const t_name * q;
+  for (i = 0; i < *pnPlaced; i++)   // If it is the tail of one already placed
+  {
+    q = apPlaced[i];
+    if (q->n >= p->n && !memcmp(&q->a[q->n - p->n], p->a, p->n))
+    {
+      p->offset = q->offset + q->n - p->n;
+      return;
+    }
+  }
+  if (nPool + p->n + 1 > MAX_POOL)
+    fail("pool too big, at", p->sName);
+  p->offset = nPool;
+  memcpy(&aPool[nPool], p->a, p->n);
+  nPool += p->n;
+  aPool[nPool++] = 0;
+  apPlaced[(*pnPlaced)++] = p;
+}
+
+void layOut(t_name ** apPlaced, int * pnPlaced)
+{
+  t_name * apAll[MAX_NAMES + MAX_TOKENS];
+  int nAll;
+  int i;
+  nPool = 1;                        // Offset 0 is the empty name
+  aPool[0] = 0;
+  nAll = 0;
+  for (i = 0; i < nTokens; i++)
+    apAll[nAll++] = &aToken[i];
+  for (i = 0; i < nNames; i++)
+    apAll[nAll++] = &aName[i];
+  qsort(apAll, nAll, sizeof(apAll[0]), byLength);
+  *pnPlaced = 0;
+  for (i = 0; i < nAll; i++)
+    place(apAll[i], apPlaced, pnPlaced);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Writing usagetext.h                                                      */
+/* ------------------------------------------------------------------------ */
+
+void printText(const uint8_t * a, int n)
+{
+  // Prints packed text as it reads, with each token in brackets
+  int i;
+  for (i = 0; i < n; i++)
+  {
+    if (a[i] >= TOKEN)
+    {
+      printf("[");
+      printText(aToken[a[i] - TOKEN].a, aToken[a[i] - TOKEN].n);
+      printf("]");
+    }
+    else
+      printf("%c", a[i]);
+  }
+}
+
+void printPool(t_name ** apPlaced, int nPlaced)
+{
+  const t_name * p;
+  int i;
+  int j;
+  int nColumn;
+  printf("const uint8_t USAGE_TEXT[] =\n{\n");
+  printf("  /* 0000 */ 0,\n");
+  for (i = 0; i < nPlaced; i++)
+  {
+    p = apPlaced[i];
+    nColumn = printf("  /* %04X */ ", p->offset);
+    for (j = 0; j < p->n; j++)
+    {
+      if (p->a[j] >= TOKEN)
+        nColumn += printf("0x%02X, ", p->a[j]);
+      else if (p->a[j] == '\'' || p->a[j] == '\\')
+        nColumn += printf("'\\%c', ", p->a[j]);
+      else
+        nColumn += printf("'%c', ", p->a[j]);
+    }
+    nColumn += printf("0,");
+    printf("%*s// ", nColumn < 60 ? 60 - nColumn : 1, "");
+    if (p >= aToken && p < aToken + nTokens)
+      printf("Token %02X: ", (int)(TOKEN + (p - aToken)));
+    printf("\"");                  // Quoted, so a name ending in \ does not continue the comment
+    printText(p->a, p->n);
+    printf("\"\n");
+  }
+  printf("};\n\n");
+}
+
+void printOffsets(const char * sName, const uint16_t * aOffset, int n, int nPerRow)
+{
+  int i;
+  printf("const uint16_t %s[] =\n{", sName);
+  for (i = 0; i < n; i++)
+  {
+    if (i % nPerRow == 0)
+      printf("\n  /* %02X */", i);
+    printf(" 0x%04X,", aOffset[i]);
+  }
+  printf("\n};\n\n");
+}
+
+void printUsages(const t_table * t)
+{
+  int i;
+  for (i = 1; i < t->nDesc; i++)
+  {
+    if (t->pUsageName[i].usage <= t->pUsageName[i-1].usage)
+      fail("usage out of ascending order", t->pUsageName[i].sName);
+  }
+  printf("const uint16_t %s[] =\n{", t->sUsageName);
+  for (i = 0; i < t->nDesc; i++)
+  {
+    if (i % 8 == 0)
+      printf("\n  /* %02X */", i);
+    printf(" 0x%03X,", t->pUsageName[i].usage);
+  }
+  printf("\n};\n\n");
+}
+
+int main()
+{
+  t_name * apPlaced[MAX_NAMES + MAX_TOKENS];
+  uint16_t aOffset[MAX_POOL];
+  const t_fragment * p;
+  const t_table * t;
+  int nPlaced;
+  int nBefore;
+  int nPointers;
+  int i;
+  int j;
+
+  nBefore = 0;
+  nPointers = 0;
+  for (t = TABLE; t < TABLE + ELEMENTS(TABLE); t++)
+  {
+    nPointers += t->nDesc;
+    for (j = 0; j < t->nDesc; j++)
+    {
+      addName(getDesc(t, j));
+      nBefore += strlen(getDesc(t, j)) + 1;
+    }
+  }
+  while (nTokens < MAX_TOKENS && (p = findBestFragment()) != NULL)
+    useToken(p);
+  layOut(apPlaced, &nPlaced);
+
+  printf("// Generated by tools/pubtext from usagenames.h - do not edit.\n");
+  printf("//\n");
+  printf("// The usage names packed into one pool (see tools/pubtext.c). A name is a\n");
+  printf("// run of bytes ended by 0: a byte below 0x80 is a character, and 0x80+n is\n");
+  printf("// token n, the fragment at USAGE_TOKEN[n]. Offset 0 is the empty name.\n");
+  printf("// SYSTEM_CONTROL_USAGE and CONSUMER_DEVICE_USAGE are the usages that have\n");
+  printf("// names, in ascending order, and the _TEXT arrays after them their names.\n\n");
+  printPool(apPlaced, nPlaced);
+  for (i = 0; i < nTokens; i++)
+    aOffset[i] = aToken[i].offset;
+  printOffsets("USAGE_TOKEN", aOffset, nTokens, 8);
+  for (t = TABLE; t < TABLE + ELEMENTS(TABLE); t++)
+  {
+    if (t->pUsageName)
+      printUsages(t);
+    for (j = 0; j < t->nDesc; j++)
+      aOffset[j] = *getDesc(t, j) ? findName(getDesc(t, j))->offset : 0;
+    printOffsets(t->sName, aOffset, t->nDesc, 8);
+  }
+
+  fprintf(stderr, "pubtext: %d names (%d bytes and %d pointers) packed into %d bytes with %d tokens\n",
+    nNames, nBefore, nPointers, nPool, nTokens);
+  return 0;
+}